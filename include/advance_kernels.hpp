@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+/// @brief Kernels summing glyph advances over UTF-8 byte spans, using an advance table for ASCII bytes
+/// @note Picked at compile time: AVX2 (gathers), SSE2 or NEON when available, scalar otherwise.
+///       Advances are whole pixels, so sums are exact and every kernel gives bit-identical results
+namespace AdvanceKernels {
+
+/// @brief Sums advances of the ASCII bytes at the start of a span
+/// @param table advance of each ASCII byte (128 entries)
+/// @param bytes bytes to measure
+/// @param count number of bytes
+/// @param sum advance sum, added to
+/// @return number of bytes consumed, stops at the first non-ASCII byte
+size_t sumAscii(const float *table, const unsigned char *bytes, size_t count, float &sum);
+
+/// @brief Writes running advance sums of the ASCII bytes at the start of a span
+/// @param table advance of each ASCII byte (128 entries)
+/// @param bytes bytes to measure
+/// @param count number of bytes
+/// @param sum advance sum before first byte, updated to sum after last consumed one
+/// @param scale factor applied to every written sum (not to sum itself)
+/// @param out where to write, sum * scale after each consumed byte
+/// @return number of bytes consumed, stops at the first non-ASCII byte
+size_t prefixAscii(const float *table, const unsigned char *bytes, size_t count, float &sum, float scale, float *out);
+
+} // AdvanceKernels
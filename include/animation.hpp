@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include "dim.hpp"
+#include "easing_kernels.hpp"
+#include "quad.hpp"
+
+/// @brief Animatable quad properties
+enum class QuadProperty : uint8_t {
+    /// @brief Rotation in radians, 1 value
+    rotation,
+
+    /// @brief Color, 4 values
+    color,
+
+    /// @brief Position, 4 values (pixels and scale of each axis), pixels are rounded
+    position,
+
+    /// @brief Size, 4 values (pixels and scale of each axis), pixels are rounded
+    size,
+};
+
+/// @brief Namespace for quad property animations (tweens)
+/// @note Animated values are kept as arrays, one entry per animated float, and evaluated
+///       in one vectorized pass per frame (see EasingKernels) before being written to the quads
+namespace Animations {
+
+/// @brief Animates quad rotation from its current value, replacing any rotation animation on it
+/// @param target quad
+/// @param to final rotation in radians
+/// @param start start time in seconds, on the same clock as update
+/// @param duration duration in seconds
+/// @param easing easing curve
+void animateRotation(QuadHandle target, float to, float start, float duration, Easing easing = Easing::easeInOut);
+
+/// @brief Animates quad color from its current value, replacing any color animation on it
+/// @param target quad
+/// @param to final color
+/// @param start start time in seconds, on the same clock as update
+/// @param duration duration in seconds
+/// @param easing easing curve
+void animateColor(QuadHandle target, const glm::vec4 &to, float start, float duration, Easing easing = Easing::easeInOut);
+
+/// @brief Animates quad position from its current value, replacing any position animation on it
+/// @param target quad
+/// @param to final position
+/// @param start start time in seconds, on the same clock as update
+/// @param duration duration in seconds
+/// @param easing easing curve
+void animatePosition(QuadHandle target, const Dim2 &to, float start, float duration, Easing easing = Easing::easeInOut);
+
+/// @brief Animates quad size from its current value, replacing any size animation on it
+/// @param target quad
+/// @param to final size
+/// @param start start time in seconds, on the same clock as update
+/// @param duration duration in seconds
+/// @param easing easing curve
+void animateSize(QuadHandle target, const Dim2 &to, float start, float duration, Easing easing = Easing::easeInOut);
+
+/// @brief Stops animating a quad property, which keeps its current value
+/// @param target quad
+/// @param property property
+void stop(QuadHandle target, QuadProperty property);
+
+/// @brief Stops every animation
+void clear();
+
+/// @brief Advances animations, writing values to their quads. Finished ones are removed,
+///        as are the ones whose quad was destroyed
+/// @param now current time in seconds
+/// @return whether any animation is still running, so the caller can sleep when idle
+bool update(float now);
+
+/// @brief Whether any animation is running
+/// @return whether there's work for next update
+bool isAnimating();
+
+/// @brief Get number of animated values
+/// @return number of values, each animation has 1 to 4
+size_t count();
+
+} // Animations
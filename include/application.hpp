@@ -1,8 +1,12 @@
 #pragma once
 
+// Scene brings in glad, which must come before GLFW
+#include "scene.hpp"
+
 #include <GLFW/glfw3.h>
 
 #include <string>
+#include <chrono>
 
 /// @brief Class to handle an application
 class Application {
@@ -64,14 +68,36 @@ public:
     /// @param codepoint Character UTF-32 codepoint
     virtual void charCallback(unsigned int codepoint);
 
+    /// @brief Callback for mouse wheel/touchpad scroll
+    /// @param xoffset horizontal scroll offset
+    /// @param yoffset vertical scroll offset
+    virtual void scrollCallback(double xoffset, double yoffset);
+
+    /// @brief Gets time from construction until the first frame was presented
+    /// @return time in milliseconds, negative if no frame was presented yet
+    float timeToFirstFrame() const;
+
 protected:
     /// @brief Callback for input processing
     /// @param window
     virtual void processInput();
 
+    /// @brief Presents rendered frame, measuring time to first frame on the first call
+    void swapBuffers();
+
     /// @brief GLFW window
     GLFWwindow *window;
 
     /// @brief Window title
     std::string title;
+
+    /// @brief Root of the Quad tree, resized along with the window
+    Scene scene;
+
+private:
+    /// @brief When the constructor started
+    std::chrono::steady_clock::time_point _createdAt;
+
+    /// @brief Time to first frame in milliseconds, negative until then
+    float _timeToFirstFrame = -1.0f;
 };
\ No newline at end of file
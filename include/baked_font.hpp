@@ -0,0 +1,156 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+#include "font.hpp"
+#include "mapped_file.hpp"
+
+/// @brief Version of baked font files, bumped whenever the layout changes
+#define BAKED_FONT_VERSION 1
+
+/// @brief Font rasterized ahead of time into a single atlas, read from a memory-mapped file
+/// @note File layout: header, glyph records, kerning pairs, then 8-bit atlas pixels (rows top to bottom)
+class BakedFont {
+public:
+    /// @brief File header
+    struct Header {
+        /// @brief Identifies file type, always "OGLUIFNT"
+        char magic[8];
+
+        /// @brief File layout version
+        uint32_t version;
+
+        /// @brief How glyphs were rasterized (GlyphRenderMode)
+        uint32_t renderMode;
+
+        /// @brief Hash of the TTF file the font was baked from
+        uint64_t ttfHash;
+
+        /// @brief Font height in pixels
+        float fontHeight;
+
+        /// @brief Height in pixels of tallest character
+        float maxCharHeight;
+
+        /// @brief Highest offset below baseline in pixels
+        float maxCharUnderflow;
+
+        /// @brief Number of glyph records
+        uint32_t numGlyphs;
+
+        /// @brief Number of kerning pairs
+        uint32_t numKerningPairs;
+
+        /// @brief Atlas width in pixels
+        uint32_t atlasWidth;
+
+        /// @brief Atlas height in pixels
+        uint32_t atlasHeight;
+
+        /// @brief Unused, keeps offsets 8-byte aligned
+        uint32_t reserved;
+
+        /// @brief Offset in bytes of glyph records
+        uint64_t glyphsOffset;
+
+        /// @brief Offset in bytes of kerning pairs
+        uint64_t kerningOffset;
+
+        /// @brief Offset in bytes of atlas pixels
+        uint64_t pixelsOffset;
+    };
+
+    /// @brief Glyph record
+    struct Glyph {
+        /// @brief Unicode codepoint
+        uint32_t codepoint;
+
+        /// @brief Bitmap position on atlas in pixels
+        uint32_t x, y;
+
+        /// @brief Bitmap size in pixels
+        uint32_t width, rows;
+
+        /// @brief Offset from baseline to top-left of glyph
+        float bearingX, bearingY;
+
+        /// @brief Horizontal offset to advance to next glyph
+        float advance;
+    };
+
+    /// @brief Kerning between two glyphs
+    struct KerningPair {
+        /// @brief Codepoint on the left
+        uint32_t left;
+
+        /// @brief Codepoint on the right
+        uint32_t right;
+
+        /// @brief Horizontal adjustment in pixels
+        float amount;
+    };
+
+    /// @brief Default constructor
+    BakedFont() = default;
+
+    /// @brief Maps a baked font file, checking it matches the given font
+    /// @param path path to baked font file
+    /// @param ttfPath path to TTF file it should have been baked from (only hashed if everything else matches)
+    /// @param fontHeight font height in pixels
+    /// @param renderMode how glyphs should have been rasterized
+    /// @return whether file exists, is valid and up to date
+    bool load(const std::string &path, const std::string &ttfPath, float fontHeight, GlyphRenderMode renderMode);
+
+    /// @brief Unmaps file
+    void close();
+
+    /// @brief Get file header
+    /// @return header, only valid after a successful load
+    const Header &header() const;
+
+    /// @brief Get glyph records
+    /// @return pointer to header().numGlyphs records
+    const Glyph *glyphs() const;
+
+    /// @brief Get kerning pairs
+    /// @return pointer to header().numKerningPairs pairs
+    const KerningPair *kerningPairs() const;
+
+    /// @brief Get atlas pixels
+    /// @return pointer to header().atlasWidth * header().atlasHeight bytes
+    const unsigned char *pixels() const;
+
+    /// @brief Writes a baked font file
+    /// @param path output path
+    /// @param header header (magic, version and offsets are filled in)
+    /// @param glyphs glyph records
+    /// @param kerningPairs kerning pairs
+    /// @param pixels atlas pixels
+    /// @return whether was successful or not
+    static bool write(
+        const std::string &path,
+        Header header,
+        const std::vector<Glyph> &glyphs,
+        const std::vector<KerningPair> &kerningPairs,
+        const std::vector<unsigned char> &pixels
+    );
+
+    /// @brief Hashes a file (64-bit FNV-1a)
+    /// @param path path to file
+    /// @return hash, empty if file couldn't be read
+    static std::optional<uint64_t> hashFile(const std::string &path);
+
+    /// @brief Gets default baked file path for a font, next to its TTF file
+    /// @param ttfPath path to font file
+    /// @param fontHeight font height in pixels
+    /// @param renderMode how glyphs are rasterized
+    /// @return path to baked font file
+    static std::string pathFor(const std::string &ttfPath, float fontHeight, GlyphRenderMode renderMode);
+
+private:
+    /// @brief Mapped file
+    MappedFile _file;
+};
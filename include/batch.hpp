@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include "font.hpp"
+
+/// @brief Namespace for the batch module, drawing quads and glyphs with a single instanced shader
+/// @note Between begin and end, Quad and glyph drawing is recorded into one instance stream in call order,
+///       then drawn with as few draw calls as possible. Only a change of glyph atlas page (or of GL state,
+///       see flush) splits a batch, so painter's order is always kept
+namespace BatchModule {
+
+/// @brief Attempts to initialize resources related to batched rendering
+/// @return whether was successful or not
+bool init();
+
+/// @brief Terminates/frees resources related to batched rendering
+void terminate();
+
+/// @brief Starts recording a frame, until end
+/// @param windowSize window size in pixels
+void begin(const glm::vec2 &windowSize);
+
+/// @brief Draws what's left of the frame and stops recording
+void end();
+
+/// @brief Whether a frame is being recorded, so draws must be submitted instead
+/// @return whether between begin and end
+bool isRecording();
+
+/// @brief Draws every instance recorded so far, needed before changing GL state (e.g. scissor)
+/// @note Does nothing if not recording or nothing was recorded
+void flush();
+
+/// @brief Records a rounded rectangle
+/// @param model model matrix, mapping [-1, 1] to pixels (only its 2D affine part is used)
+/// @param color color
+/// @param radiiTop radius of top left (xy) and top right (zw) corners, in pixels
+/// @param radiiBottom radius of bottom left (xy) and bottom right (zw) corners, in pixels
+void submitQuad(
+    const glm::mat4 &model,
+    const glm::vec4 &color,
+    const glm::vec4 &radiiTop,
+    const glm::vec4 &radiiBottom
+);
+
+/// @brief Records a glyph
+/// @param texture atlas page texture
+/// @param topLeft top left corner in pixels
+/// @param size size in pixels
+/// @param uvRect rectangle on atlas page
+/// @param color color
+/// @param renderMode how glyph was rasterized
+/// @param outlineWidth outline width in distance field units (only for signed distance field glyphs)
+/// @param outlineColor outline color (only for signed distance field glyphs)
+void submitGlyph(
+    unsigned int texture,
+    const glm::vec2 &topLeft,
+    const glm::vec2 &size,
+    const glm::vec4 &uvRect,
+    const glm::vec4 &color,
+    GlyphRenderMode renderMode,
+    float outlineWidth,
+    const glm::vec4 &outlineColor
+);
+
+/// @brief Get number of draw calls of the last recorded frame
+/// @return number of draw calls
+size_t drawCalls();
+
+/// @brief Get number of instances of the last recorded frame
+/// @return number of instances
+size_t instances();
+
+} // BatchModule
@@ -1,35 +1,37 @@
 #pragma once
 
 #include <ostream>
+#include <type_traits>
 
 #include <glm/glm.hpp>
 
 #include "dim.hpp"
 
 /// @brief Class used to build instances of BorderRadius
+/// @note Defined in this header as constexpr, like Dim
 class Radius {
 public:
     /// @brief Constructor for elliptical radius
     /// @param r radius 2D dimension
     /// @return elliptical radius
-    static Radius elliptical(const Dim2 &r);
+    static constexpr Radius elliptical(const Dim2 &r);
 
     /// @brief Constructor for circular radius
     /// @param r radius dimension
     /// @return circular radius
-    static Radius circular(const Dim &r);
+    static constexpr Radius circular(const Dim &r);
 
     /// @brief Empty radius
     /// @return radius with no rounding
-    static Radius zero();
+    static constexpr Radius zero();
 
     /// @brief Gets the horizontal radius
     /// @return horizontal radius in current scale
-    Dim x() const;
+    constexpr Dim x() const;
 
     /// @brief Gets the vertical radius
     /// @return vertical radius in current scale
-    Dim y() const;
+    constexpr Dim y() const;
 
     /// @brief Returns this radius measured as scale
     /// @param viewportSize viewport render size vector in pixels
@@ -51,7 +53,7 @@ private:
     /// @brief Default constructor
     /// @param x radius dimension on x-axis
     /// @param y radius dimension on y-axis
-    Radius(const Dim &x, const Dim &y);
+    constexpr Radius(const Dim &x, const Dim &y);
 
     /// @brief Radius dimension on x-axis
     Dim _x;
@@ -68,7 +70,7 @@ public:
     /// @param topRight radius on top right corner
     /// @param bottomLeft radius on bottom left corner
     /// @param bottomRight radius on bottom right corner
-    BorderRadius(
+    constexpr BorderRadius(
         Radius topLeft = Radius::zero(),
         Radius topRight = Radius::zero(),
         Radius bottomLeft = Radius::zero(),
@@ -78,18 +80,18 @@ public:
     /// @brief Creates a border radius with same radii on all 4 corners
     /// @param radius radius
     /// @return border radius with equal corners
-    static BorderRadius all(Radius radius);
+    static constexpr BorderRadius all(Radius radius);
 
     /// @brief Creates a circular border radius
     /// @param radius radius
     /// @return border radius with all 4 corners circularly rounded
-    static BorderRadius circular(const Dim &r);
+    static constexpr BorderRadius circular(const Dim &r);
 
     /// @brief Creates a horizontally symmetric border radius
     /// @param left radius on both left corners
     /// @param right radius on both right corners
     /// @return horizontally symmetric border radius
-    static BorderRadius horizontal(
+    static constexpr BorderRadius horizontal(
         Radius left = Radius::zero(),
         Radius right = Radius::zero()
     );
@@ -98,30 +100,30 @@ public:
     /// @param top radius on both top corners
     /// @param bottom radius on both bottom corners
     /// @return vertically symmetric border radius
-    static BorderRadius vertical(
+    static constexpr BorderRadius vertical(
         Radius top = Radius::zero(),
         Radius bottom = Radius::zero()
     );
 
     /// @brief Empty border radius
     /// @return border radius with no rounding
-    static BorderRadius zero();
+    static constexpr BorderRadius zero();
 
     /// @brief Gets the top left radius
     /// @return top left radius
-    Radius topLeft() const;
+    constexpr Radius topLeft() const;
 
     /// @brief Gets the top right radius
     /// @return top right radius
-    Radius topRight() const;
+    constexpr Radius topRight() const;
 
     /// @brief Gets the top left radius
     /// @return top left radius
-    Radius bottomLeft() const;
+    constexpr Radius bottomLeft() const;
 
     /// @brief Gets the bottom right radius
     /// @return bottom right radius
-    Radius bottomRight() const;
+    constexpr Radius bottomRight() const;
 
     /// @brief Output operator
     /// @param os stream to send output to
@@ -141,4 +143,83 @@ private:
 
     /// @brief Radius on bottom right corner
     Radius _bottomRight;
-};
\ No newline at end of file
+};
+
+constexpr Radius::Radius(const Dim &x, const Dim &y) : _x{x}, _y{y} {}
+
+constexpr Radius Radius::elliptical(const Dim2 &r) {
+    Dim _x = Dim::max(Dim::zero(), r.x());
+    Dim _y = Dim::max(Dim::zero(), r.y());
+    return Radius{_x, _y};
+}
+
+constexpr Radius Radius::circular(const Dim &r) {
+    auto _r = Dim::max(Dim::zero(), r);
+    return Radius{_r, _r};
+}
+
+constexpr Radius Radius::zero() {
+    return Radius{Dim::zero(), Dim::zero()};
+}
+
+constexpr Dim Radius::x() const {
+    return _x;
+}
+
+constexpr Dim Radius::y() const {
+    return _y;
+}
+
+inline glm::vec2 Radius::toScale(const glm::vec2 &viewportSize) const {
+    return glm::vec2{_x.toScale(viewportSize.x), _y.toScale(viewportSize.y)};
+}
+
+inline glm::vec2 Radius::toPixels(const glm::vec2 &viewportSize) const {
+    return glm::vec2{_x.toPixels(viewportSize.x), _y.toPixels(viewportSize.y)};
+}
+
+constexpr BorderRadius::BorderRadius(
+    Radius topLeft,
+    Radius topRight,
+    Radius bottomLeft,
+    Radius bottomRight
+) : _topLeft{topLeft}, _topRight{topRight}, _bottomLeft{bottomLeft}, _bottomRight{bottomRight} {}
+
+constexpr BorderRadius BorderRadius::all(Radius radius) {
+    return BorderRadius(radius, radius, radius, radius);
+}
+
+constexpr BorderRadius BorderRadius::circular(const Dim &r) {
+    return BorderRadius::all(Radius::circular(r));
+}
+
+constexpr BorderRadius BorderRadius::horizontal(Radius left, Radius right) {
+    return BorderRadius(left, right, left, right);
+}
+
+constexpr BorderRadius BorderRadius::vertical(Radius top, Radius bottom) {
+    return BorderRadius(top, top, bottom, bottom);
+}
+
+constexpr BorderRadius BorderRadius::zero() {
+    return BorderRadius::all(Radius::zero());
+}
+
+constexpr Radius BorderRadius::topLeft() const {
+    return _topLeft;
+}
+
+constexpr Radius BorderRadius::topRight() const {
+    return _topRight;
+}
+
+constexpr Radius BorderRadius::bottomLeft() const {
+    return _bottomLeft;
+}
+
+constexpr Radius BorderRadius::bottomRight() const {
+    return _bottomRight;
+}
+
+static_assert(std::is_trivially_copyable_v<Radius>, "Radius must stay trivially copyable");
+static_assert(std::is_trivially_copyable_v<BorderRadius>, "BorderRadius must stay trivially copyable");
@@ -1,57 +1,60 @@
 #pragma once
 
 #include <ostream>
+#include <algorithm>
+#include <type_traits>
 
 #include <glm/glm.hpp>
 
 /// @brief Class to represent a dimension which holds an independent "pixels" value
 ///        and a viewport size dependent "scale" value
+/// @note Defined in this header as constexpr, so style constants are built at compile time
 class Dim {
 public:
     /// @brief Default constructor
     /// @param pixels pixels
     /// @param scale scale
-    Dim(int pixels = 0, float scale = 0.0f);
+    constexpr Dim(int pixels = 0, float scale = 0.0f);
 
     /// @brief Creates an empty/zero-ed dimension
     /// @return dimension with zero values
-    static Dim zero();
+    static constexpr Dim zero();
 
     /// @brief Constructor only for pixels
     /// @param pixels pixels
     /// @return Dim with specified pixels and zero scale
-    static Dim fromPixels(int pixels);
+    static constexpr Dim fromPixels(int pixels);
 
     /// @brief Constructor only for scale
     /// @param scale scale
     /// @return Dim with specified scale and zero pixels
-    static Dim fromScale(float scale);
+    static constexpr Dim fromScale(float scale);
 
     /// @brief Returns the maximum between two dimensions
     /// @param d0 first dimension
     /// @param d1 second dimension
     /// @return maximum of given dimensions
-    static Dim max(const Dim &d0, const Dim &d1);
+    static constexpr Dim max(const Dim &d0, const Dim &d1);
 
     /// @brief Returns the minimum between two dimensions
     /// @param d0 first dimension
     /// @param d1 second dimension
     /// @return minimum of given dimensions
-    static Dim min(const Dim &d0, const Dim &d1);
+    static constexpr Dim min(const Dim &d0, const Dim &d1);
 
     /// @brief Returns a dimension clamped to a min-max range
     /// @param d dimension to be clamped
     /// @param min minimum value
     /// @param max maximum value
     /// @return dimension clamped
-    static Dim clamp(const Dim &d, const Dim &min, const Dim &max);
+    static constexpr Dim clamp(const Dim &d, const Dim &min, const Dim &max);
 
-    Dim  operator+  (const Dim &d) const;
-    Dim& operator+= (const Dim &d);
+    constexpr Dim  operator+  (const Dim &d) const;
+    constexpr Dim& operator+= (const Dim &d);
 
-    Dim  operator-  () const;
-    Dim  operator-  (const Dim &d) const;
-    Dim& operator-= (const Dim &d);
+    constexpr Dim  operator-  () const;
+    constexpr Dim  operator-  (const Dim &d) const;
+    constexpr Dim& operator-= (const Dim &d);
 
     /// @brief Output operator
     /// @param os stream to send output to
@@ -61,21 +64,21 @@ public:
 
     /// @brief Get pixels
     /// @return pixels
-    int pixels() const;
+    constexpr int pixels() const;
 
     /// @brief Get scale
     /// @return scale
-    float scale() const;
+    constexpr float scale() const;
 
     /// @brief Returns this dimension measured as scale
     /// @param dimensionSize max dimension size in pixels
     /// @return dimension in scale
-    float toScale(float dimensionSize) const;
+    constexpr float toScale(float dimensionSize) const;
 
     /// @brief Returns this dimension measured as pixels
     /// @param dimensionSize max dimension size in pixels
     /// @return dimension in pixels
-    float toPixels(float dimensionSize) const;
+    constexpr float toPixels(float dimensionSize) const;
 
 private:
     /// @brief Dimension in pixels, independent of viewport size
@@ -91,59 +94,59 @@ public:
     /// @brief Default constructor
     /// @param x dimension in x-axis
     /// @param y dimension in y-axis
-    Dim2(const Dim &x, const Dim &y);
+    constexpr Dim2(const Dim &x, const Dim &y);
 
     /// @brief Constructor with separated params
     /// @param pixelsX pixels in x-axis
     /// @param scaleX scale in x-axis
     /// @param pixelsY pixels in y-axis
     /// @param scaleY scale in y-axis
-    Dim2(
+    constexpr Dim2(
         int pixelsX = 0, float scaleX = 0.0f,
         int pixelsY = 0, float scaleY = 0.0f
     );
 
     /// @brief Creates an empty/zero-ed 2D dimension
     /// @return 2D dimension with zero values
-    static Dim2 zero();
+    static constexpr Dim2 zero();
 
     /// @brief Constructor only for pixels
     /// @param x pixels in x-axis
     /// @param y pixels in y-axis
     /// @return Dim with specified pixels dimensions and zero scale
-    static Dim2 fromPixels(int x, int y);
+    static constexpr Dim2 fromPixels(int x, int y);
 
     /// @brief Constructor only for scale
     /// @param x scale in x-axis
     /// @param y scale in y-axis
     /// @return Dim with specified scale dimensions and zero pixels
-    static Dim2 fromScale(float x, float y);
+    static constexpr Dim2 fromScale(float x, float y);
 
     /// @brief Returns the maximum between two 2D dimensions
     /// @param d0 first 2D dimension
     /// @param d1 second 2D dimension
     /// @return maximum of given 2D dimensions
-    static Dim2 max(const Dim2 &d0, const Dim2 &d1);
+    static constexpr Dim2 max(const Dim2 &d0, const Dim2 &d1);
 
     /// @brief Returns the minimum between two 2D dimensions
     /// @param d0 first 2D dimension
     /// @param d1 second 2D dimension
     /// @return minimum of given 2D dimensions
-    static Dim2 min(const Dim2 &d0, const Dim2 &d1);
+    static constexpr Dim2 min(const Dim2 &d0, const Dim2 &d1);
 
     /// @brief Returns a 2D dimension clamped to a min-max range
     /// @param d 2D dimension to be clamped
     /// @param min minimum value
     /// @param max maximum value
     /// @return 2D dimension clamped
-    static Dim2 clamp(const Dim2 &d, const Dim2 &min, const Dim2 &max);
+    static constexpr Dim2 clamp(const Dim2 &d, const Dim2 &min, const Dim2 &max);
 
-    Dim2  operator+  (const Dim2& d) const;
-    Dim2& operator+= (const Dim2 &d);
+    constexpr Dim2  operator+  (const Dim2& d) const;
+    constexpr Dim2& operator+= (const Dim2 &d);
 
-    Dim2  operator-  () const;
-    Dim2  operator-  (const Dim2 &d) const;
-    Dim2& operator-= (const Dim2 &d);
+    constexpr Dim2  operator-  () const;
+    constexpr Dim2  operator-  (const Dim2 &d) const;
+    constexpr Dim2& operator-= (const Dim2 &d);
 
     /// @brief Output operator
     /// @param os stream to send output to
@@ -153,11 +156,11 @@ public:
 
     /// @brief Get dimension in x-axis
     /// @return dimension in x-axis
-    Dim x() const;
+    constexpr Dim x() const;
 
     /// @brief Get dimension in y-axis
     /// @return dimension in y-axis
-    Dim y() const;
+    constexpr Dim y() const;
 
     /// @brief Returns this 2D dimension measured as scale
     /// @param windowSize render viewport size vector in pixels
@@ -176,3 +179,167 @@ private:
     /// @brief Dimension in y-axis
     Dim _y;
 };
+
+constexpr Dim::Dim(int pixels, float scale) : _pixels{pixels}, _scale{scale} {}
+
+constexpr Dim Dim::zero() {
+    return Dim{0, 0.0f};
+}
+
+constexpr Dim Dim::fromPixels(int pixels) {
+    return Dim{pixels, 0.0f};
+}
+
+constexpr Dim Dim::fromScale(float scale) {
+    return Dim{0, scale};
+}
+
+constexpr Dim Dim::max(const Dim &d0, const Dim &d1) {
+    return Dim{
+        std::max(d0.pixels(), d1.pixels()),
+        std::max(d0.scale(), d1.scale())
+    };
+}
+
+constexpr Dim Dim::min(const Dim &d0, const Dim &d1) {
+    return Dim{
+        std::min(d0.pixels(), d1.pixels()),
+        std::min(d0.scale(), d1.scale())
+    };
+}
+
+constexpr Dim Dim::clamp(const Dim &d, const Dim &min, const Dim &max) {
+    return Dim{
+        std::clamp(d.pixels(), min.pixels(), max.pixels()),
+        std::clamp(d.scale(), min.scale(), max.scale()),
+    };
+}
+
+constexpr Dim Dim::operator+ (const Dim &d) const {
+    Dim tmp{*this};
+    tmp += d;
+    return tmp;
+}
+
+constexpr Dim &Dim::operator+= (const Dim &d) {
+    _pixels += d.pixels();
+    _scale += d.scale();
+    return *this;
+}
+
+constexpr Dim Dim::operator- () const {
+    return Dim{-_pixels, -_scale};
+}
+
+constexpr Dim Dim::operator- (const Dim &d) const {
+    Dim tmp{*this};
+    tmp -= d;
+    return tmp;
+}
+
+constexpr Dim &Dim::operator-= (const Dim &d) {
+    *this += -d;
+    return *this;
+}
+
+constexpr int Dim::pixels() const {
+    return _pixels;
+}
+
+constexpr float Dim::scale() const {
+    return _scale;
+}
+
+constexpr float Dim::toScale(float dimensionSize) const {
+    return _scale + (float)_pixels / dimensionSize;
+}
+
+constexpr float Dim::toPixels(float dimensionSize) const {
+    return _scale * dimensionSize + _pixels;
+}
+
+constexpr Dim2::Dim2(const Dim &x, const Dim &y) : _x{x}, _y{y} {}
+
+constexpr Dim2::Dim2(
+    int pixelsX , float scaleX,
+    int pixelsY, float scaleY
+) : _x{pixelsX, scaleX}, _y{pixelsY, scaleY} {}
+
+constexpr Dim2 Dim2::zero() {
+    return Dim2{Dim::zero(), Dim::zero()};
+}
+
+constexpr Dim2 Dim2::fromPixels(int x, int y) {
+    return Dim2{Dim::fromPixels(x), Dim::fromPixels(y)};
+}
+
+constexpr Dim2 Dim2::fromScale(float x, float y) {
+    return Dim2{Dim::fromScale(x), Dim::fromScale(y)};
+}
+
+constexpr Dim2 Dim2::max(const Dim2 &d0, const Dim2 &d1) {
+    return Dim2{
+        Dim::max(d0.x(), d1.x()),
+        Dim::max(d0.y(), d1.y())
+    };
+}
+
+constexpr Dim2 Dim2::min(const Dim2 &d0, const Dim2 &d1) {
+    return Dim2{
+        Dim::min(d0.x(), d1.x()),
+        Dim::min(d0.y(), d1.y())
+    };
+}
+
+constexpr Dim2 Dim2::clamp(const Dim2 &d, const Dim2 &min, const Dim2 &max) {
+    return Dim2{
+        Dim::clamp(d.x(), min.x(), max.x()),
+        Dim::clamp(d.y(), min.y(), max.y()),
+    };
+}
+
+constexpr Dim2 Dim2::operator+ (const Dim2 &d) const {
+    Dim2 tmp{*this};
+    tmp += d;
+    return tmp;
+}
+
+constexpr Dim2 &Dim2::operator+= (const Dim2 &d) {
+    _x += d.x();
+    _y += d.y();
+    return *this;
+}
+
+constexpr Dim2 Dim2::operator- () const {
+    return Dim2{-_x, -_y};
+}
+
+constexpr Dim2 Dim2::operator- (const Dim2 &d) const {
+    Dim2 tmp{*this};
+    tmp -= d;
+    return tmp;
+}
+
+constexpr Dim2 &Dim2::operator-= (const Dim2 &d) {
+    *this += -d;
+    return *this;
+}
+
+constexpr Dim Dim2::x() const {
+    return _x;
+}
+
+constexpr Dim Dim2::y() const {
+    return _y;
+}
+
+inline glm::vec2 Dim2::toScale(const glm::vec2 &windowSize) const {
+    return glm::vec2{_x.toScale(windowSize.x), _y.toScale(windowSize.y)};
+}
+
+inline glm::vec2 Dim2::toPixels(const glm::vec2 &windowSize) const {
+    return glm::vec2{_x.toPixels(windowSize.x), _y.toPixels(windowSize.y)};
+}
+
+static_assert(std::is_trivially_copyable_v<Dim>, "Dim must stay trivially copyable");
+static_assert(std::is_trivially_copyable_v<Dim2>, "Dim2 must stay trivially copyable");
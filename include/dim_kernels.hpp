@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+/// @brief Kernels resolving packed Dim coefficients into pixels, many at once
+/// @note Picked at compile time: AVX2, SSE2 or NEON when available, scalar otherwise
+namespace DimKernels {
+
+/// @brief Resolves interleaved (x, y) dimensions against an axis size, out = pixels + scales * axis
+/// @param pixels pixel coefficients, 2 * count floats
+/// @param scales scale coefficients, 2 * count floats
+/// @param count number of (x, y) pairs
+/// @param axisX size x scales are relative to
+/// @param axisY size y scales are relative to
+/// @param out where to write, 2 * count floats
+void resolve(const float *pixels, const float *scales, size_t count, float axisX, float axisY, float *out);
+
+/// @brief Get name of the kernels compiled in
+/// @return "avx2", "sse2", "neon" or "scalar"
+const char *name();
+
+} // DimKernels
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Easing curves, mapping animation progress in [0, 1] to interpolation factor in [0, 1]
+enum class Easing : uint32_t {
+    linear,
+
+    /// @brief Quadratic, starts slow
+    easeIn,
+
+    /// @brief Quadratic, ends slow
+    easeOut,
+
+    /// @brief Quadratic, starts and ends slow
+    easeInOut,
+};
+
+/// @brief Kernels evaluating many eased interpolations at once, stored as arrays (one entry per value)
+/// @note Picked at compile time: AVX2, SSE2 or NEON when available, scalar otherwise.
+///       Every curve is evaluated branch-free and selected per lane, so mixed easings share a pass
+namespace EasingKernels {
+
+/// @brief Evaluates interpolations at a point in time, out = from + (to - from) * ease(progress)
+/// @param from start values
+/// @param to end values
+/// @param start start times
+/// @param duration durations, must be positive
+/// @param easing easing of each value
+/// @param count number of values
+/// @param now time to evaluate at, progress is clamped to [0, 1]
+/// @param out where to write, count floats
+void evaluate(
+    const float *from, const float *to,
+    const float *start, const float *duration,
+    const Easing *easing, size_t count,
+    float now, float *out
+);
+
+/// @brief Get name of the kernels compiled in
+/// @return "avx2", "sse2", "neon" or "scalar"
+const char *name();
+
+} // EasingKernels
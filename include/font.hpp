@@ -1,18 +1,43 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <memory>
+#include <cstdint>
 
 #include <glm/glm.hpp>
 
 #include "freetype/ft2build.h"
 #include FT_FREETYPE_H
 
+#include "font_metrics.hpp"
+
 /// @brief Font character list start char
 #define CHARS_START 32
 
 /// @brief Font character list length
 #define CHARS_LEN 95
 
+/// @brief Default maximum glyph atlas texture memory per font, in bytes
+#define DEFAULT_GLYPH_ATLAS_BUDGET (4 * 1024 * 1024)
+
+/// @brief Default maximum number of background rasterized glyphs uploaded to atlases at once
+#define MAX_GLYPH_UPLOADS_PER_FRAME 64
+
+/// @brief Distance in pixels stored by signed distance field glyphs on each side of their outline
+#define SDF_SPREAD 8
+
+/// @brief How glyphs of a font are rasterized
+enum class GlyphRenderMode {
+    /// @brief Coverage bitmaps, only sharp near the font loaded height
+    bitmap,
+
+    /// @brief Signed distance fields, sharp at any size
+    sdf,
+};
+
+class MappedFile;
+
 /// @brief Namespace for font module
 namespace FontModule {
 
@@ -24,46 +49,107 @@ bool init(const std::string &rootPath);
 /// @brief Terminates/frees resources related to fonts
 void terminate();
 
+/// @brief Sets glyph atlas memory budget for fonts loaded from now on
+/// @param budget maximum atlas texture memory per font, in bytes
+void setGlyphAtlasBudget(size_t budget);
+
+/// @brief Gets glyph atlas memory budget for new fonts
+/// @return maximum atlas texture memory per font, in bytes
+size_t glyphAtlasBudget();
+
+/// @brief Sets number of worker threads rasterizing glyphs in background
+/// @param numThreads number of threads, 0 to rasterize on the calling thread
+/// @note While enabled, glyphs that aren't on the atlas yet have no texture until uploaded,
+///       and are skipped when drawn. Can be called before or after init
+void setRasterizerThreads(unsigned int numThreads);
+
+/// @brief Gets number of worker threads rasterizing glyphs in background
+/// @return number of threads, 0 if disabled
+unsigned int rasterizerThreads();
+
+/// @brief Maps a font file in memory, sharing the mapping with every face already made from it
+/// @param path full path to font file
+/// @return mapped file (unmapped once the last reference goes away), null if it couldn't be opened
+std::shared_ptr<const MappedFile> mapFontFile(const std::string &path);
+
+/// @brief Uploads glyphs finished by background rasterizer to their font atlases
+/// @param maxGlyphs maximum number of glyphs to upload, so a burst is spread over a few frames
+/// @note Must be called from the OpenGL thread, text drawing calls it on its own
+void uploadRasterizedGlyphs(size_t maxGlyphs = MAX_GLYPH_UPLOADS_PER_FRAME);
+
 } // FontModule
 
+class BakedFont;
+
 /// @brief Wrapper struct for FreeType glyph struct
 struct Character {
-    /// @brief OpenGL texture ID
+    /// @brief OpenGL texture ID of the atlas page holding the glyph
+    /// @note Only up to date on values returned by Font::getGlyph, since glyphs can be evicted
     unsigned int textureID;
 
+    /// @brief Glyph rectangle on atlas page texture, as offset (xy) and size (zw) in [0-1] range
+    /// @note Only up to date on values returned by Font::getGlyph, since glyphs can be evicted
+    glm::vec4 uvRect;
+
     /// @brief Size of glyph in pixels
+    /// @note Taken from outline metrics until the glyph is rasterized, then from its bitmap
     glm::vec2 size;
 
     /// @brief Offset from baseline to top-left of glyph
+    /// @note Taken from outline metrics until the glyph is rasterized, then from its bitmap
     glm::vec2 bearing;
 
     /// @brief Horizontal offset to advance to next glyph
     float advance;
+
+    /// @brief Atlas slot last used by the glyph
+    uint32_t atlasSlot;
 };
 
-/// @brief Class to hold data about a TTF font
+/// @brief Handle to a TTF font loaded at a given size, cheap to copy
+/// @note Handles to the same path, size and render mode share one glyph store, which is freed
+///       when the last handle goes away
 class Font {
 public:
-    /// @brief Default constructor
+    /// @brief Default constructor, handle to no font
     Font() = default;
 
-    /// @brief Constructor with TTF file path
+    /// @brief Constructor with TTF file path, loading the font unless it's already loaded
+    /// @note If a baked font file made from the same TTF exists (see BakedFont::pathFor), its glyphs
+    ///       are loaded from it without FreeType
     /// @param ttfPath path to font file
     /// @param fontHeight font height in pixels
-    Font(const std::string &ttfPath, float fontHeight = 48.0f);
-
-    /// @brief Get character info for a specific char
-    /// @param c char
-    /// @return character info for given char
-    Character getCharInfo(char c);
+    /// @param lazy if true, only the face is opened here and every glyph is rasterized on first draw,
+    ///             otherwise printable ASCII glyphs are rasterized right away
+    /// @param renderMode how glyphs are rasterized
+    Font(const std::string &ttfPath, float fontHeight = 48.0f, bool lazy = false, GlyphRenderMode renderMode = GlyphRenderMode::bitmap);
+
+    /// @brief Get character metrics for a specific codepoint, loading them on first use
+    /// @param codepoint unicode codepoint
+    /// @return character info for given codepoint
+    /// @note Doesn't rasterize the glyph, so it can be used for layout without touching the atlas
+    const Character &getCharInfo(uint32_t codepoint);
+
+    /// @brief Get character info for a specific codepoint, making sure its bitmap is on the atlas
+    /// @param codepoint unicode codepoint
+    /// @return character info for given codepoint, with valid texture data
+    /// @note With background rasterization, the glyph is requested instead and has no texture
+    ///       (textureID 0) until uploaded
+    const Character &getGlyph(uint32_t codepoint);
+
+    /// @brief Get horizontal kerning between two codepoints
+    /// @param left codepoint on the left
+    /// @param right codepoint on the right
+    /// @return adjustment to add to left advance, in pixels
+    float getKerning(uint32_t left, uint32_t right);
 
     /// @brief Calculates text width as if it was written in a single horizontal line
-    /// @param text text to calculate width
+    /// @param text UTF-8 text to calculate width
     /// @param fontSize font size in pixels
     /// @return text width in pixels
-    float calculateTextWidth(const std::string &text, float fontSize = 14.0f);
+    float calculateTextWidth(std::string_view text, float fontSize = 14.0f);
 
-    /// @brief Returns internal FreeType Face pointer
+    /// @brief Returns internal FreeType Face pointer, opening it if font was baked
     /// @return Internal FT_Face
     FT_Face getFreeTypeFace() const;
 
@@ -71,27 +157,64 @@ public:
     /// @return Font height in pixels
     float fontHeight() const;
 
-    /// @brief Height in pixels of tallest character in this font
+    /// @brief How glyphs of this font are rasterized
+    /// @return Render mode
+    GlyphRenderMode renderMode() const;
+
+    /// @brief Height in pixels of tallest character in this font (ascender to descender)
     /// @return Max height in pixels
     float maxCharHeight() const;
 
-    /// @brief Highest offset below baseline in pixels in this font
+    /// @brief Highest offset below baseline in pixels in this font (descender)
     /// @return Offset in pixels
     float maxCharUnderflow() const;
 
-private:
-    /// @brief FreeType face object
-    FT_Face _face;
+    /// @brief Get glyph metrics, which can be used for layout on any thread without OpenGL
+    /// @return metrics shared by every handle of this font
+    std::shared_ptr<const FontMetrics> metrics() const;
+
+    /// @brief Whether this handle points to a font
+    /// @return whether font is loaded
+    bool isLoaded() const;
 
-    /// @brief Font height in pixels
-    float _fontHeight;
+    /// @brief Identifier of the font this handle points to, never reused by other fonts
+    /// @return font identifier
+    uint64_t id() const;
 
-    /// @brief Height in pixels of tallest character
-    float _maxCharHeight;
+    /// @brief Number of handles sharing this font
+    /// @return Handle count, 0 if not loaded
+    long useCount() const;
 
-    /// @brief Highest offset below baseline in pixels
-    float _maxCharUnderflow;
+    /// @brief Frees FreeType face and glyph textures right away, for every handle of this font
+    void destroy();
 
-    /// @brief Array of all printable ASCII characters from 32 to 126
-    Character _characters[CHARS_LEN];
+    /// @brief Font info and loaded glyphs (implementation detail)
+    struct Glyphs;
+
+private:
+    /// @brief Gets a loaded character, loading it if needed
+    /// @param codepoint unicode codepoint, already normalized
+    /// @return loaded character
+    Character &loadCharacter(uint32_t codepoint);
+
+    /// @brief Loads glyph metrics without rasterizing it
+    /// @param codepoint unicode codepoint, already normalized
+    /// @param character character to fill
+    void loadMetrics(uint32_t codepoint, Character &character);
+
+    /// @brief Rasterizes a glyph into the atlas, updating its metrics
+    /// @param codepoint unicode codepoint, already normalized
+    /// @param character character to fill
+    void rasterize(uint32_t codepoint, Character &character);
+
+    /// @brief Loads glyphs from a baked font, uploading its atlas
+    /// @param baked loaded baked font
+    void loadBaked(const BakedFont &baked);
+
+    /// @brief Gets FreeType face, opening it on first use
+    /// @return FreeType face
+    FT_Face face() const;
+
+    /// @brief Font info and loaded glyphs, shared by all handles to this font
+    std::shared_ptr<Glyphs> _glyphs;
 };
\ No newline at end of file
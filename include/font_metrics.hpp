@@ -0,0 +1,172 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <atomic>
+#include <shared_mutex>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "freetype/ft2build.h"
+#include FT_FREETYPE_H
+
+class MappedFile;
+class BakedFont;
+
+/// @brief Gets description of a FreeType error
+/// @param error FreeType error code
+/// @return error description
+const char *FT_Error_String(FT_Error error);
+
+/// @brief Prints a FreeType error on debug builds
+/// @param prefix text printed before error description
+/// @param code FreeType error code
+void FT_CheckError(const std::string &prefix, FT_Error code);
+
+/// @brief Layout metrics of a glyph, with no GPU data
+struct GlyphMetrics {
+    /// @brief Size of glyph in pixels
+    glm::vec2 size;
+
+    /// @brief Offset from baseline to top-left of glyph
+    glm::vec2 bearing;
+
+    /// @brief Horizontal offset to advance to next glyph
+    float advance;
+};
+
+/// @brief Glyph metrics of a font at a given size, loaded on the CPU only
+/// @note Doesn't need an OpenGL context nor FontModule, and can be shared by any number of threads:
+///       loaded metrics are read without locking, and loading new ones is serialized
+class FontMetrics {
+public:
+    /// @brief Constructor, opening a face on the given font file
+    /// @param file mapped font file, kept alive while metrics exist
+    /// @param fontHeight font height in pixels
+    /// @param baked baked font to take metrics and kerning from (if any), so FreeType is only used
+    ///              for codepoints that weren't baked
+    FontMetrics(std::shared_ptr<const MappedFile> file, float fontHeight, const BakedFont *baked = nullptr);
+
+    /// @brief Constructor, mapping a font file
+    /// @param path path to font file
+    /// @param fontHeight font height in pixels
+    FontMetrics(const std::string &path, float fontHeight);
+
+    /// @brief Destructor, frees FreeType face
+    ~FontMetrics();
+
+    FontMetrics(const FontMetrics &) = delete;
+    FontMetrics &operator= (const FontMetrics &) = delete;
+
+    /// @brief Get metrics of a codepoint, loading them on first use
+    /// @param codepoint unicode codepoint
+    /// @return glyph metrics, which stay valid for the lifetime of this object
+    const GlyphMetrics &get(uint32_t codepoint) const;
+
+    /// @brief Get advance of a codepoint, from the advance table for ASCII
+    /// @param codepoint unicode codepoint
+    /// @return horizontal offset to next glyph in pixels, at font height
+    float advance(uint32_t codepoint) const;
+
+    /// @brief Get horizontal kerning between two codepoints
+    /// @param left codepoint on the left
+    /// @param right codepoint on the right
+    /// @return adjustment to add to left advance, in pixels
+    float kerning(uint32_t left, uint32_t right) const;
+
+    /// @brief Calculates text width as if it was written in a single horizontal line
+    /// @param text UTF-8 text to calculate width
+    /// @param fontSize font size in pixels
+    /// @return text width in pixels
+    float textWidth(std::string_view text, float fontSize) const;
+
+    /// @brief Calculates width of every prefix of a text, as if it was written in a single horizontal line
+    /// @param text UTF-8 text to measure
+    /// @param fontSize font size in pixels
+    /// @param out text.size() + 1 widths, out[i] being the width of the codepoints fully inside text[0, i)
+    void prefixWidths(std::string_view text, float fontSize, float *out) const;
+
+    /// @brief Size of a box fitting any glyph of the face, opening the face if needed
+    /// @return size in pixels, at font height (bounding box for scalable faces, max advance by height otherwise)
+    glm::ivec2 glyphBounds() const;
+
+    /// @brief At which height were metrics loaded at
+    /// @return Font height in pixels
+    float fontHeight() const;
+
+    /// @brief Height in pixels of tallest character (ascender to descender)
+    /// @return Max height in pixels
+    float maxCharHeight() const;
+
+    /// @brief Highest offset below baseline in pixels (descender)
+    /// @return Offset in pixels
+    float maxCharUnderflow() const;
+
+    /// @brief Maps codepoints with no glyph of their own to the one used in their place
+    /// @param codepoint unicode codepoint
+    /// @return codepoint to be loaded
+    static uint32_t normalize(uint32_t codepoint);
+
+private:
+    /// @brief Loaded glyph
+    struct Entry {
+        /// @brief Glyph metrics
+        GlyphMetrics metrics;
+
+        /// @brief Whether glyph came from a baked font
+        bool baked;
+    };
+
+    /// @brief Gets a loaded glyph, loading it if needed
+    /// @param codepoint unicode codepoint, already normalized
+    /// @return loaded glyph
+    const Entry &entry(uint32_t codepoint) const;
+
+    /// @brief Gets advance table, filling it on first use
+    /// @return advance of every ASCII codepoint at font height
+    const float *asciiAdvances() const;
+
+    /// @brief Gets FreeType face, opening it on first use (must hold unique lock)
+    /// @return FreeType face
+    FT_Face face() const;
+
+    /// @brief Mapped font file
+    std::shared_ptr<const MappedFile> _file;
+
+    /// @brief Font height in pixels
+    float _fontHeight;
+
+    /// @brief Height in pixels of tallest character
+    float _maxCharHeight = 0.0f;
+
+    /// @brief Highest offset below baseline in pixels
+    float _maxCharUnderflow = 0.0f;
+
+    /// @brief FreeType library owned by these metrics, since libraries can't be shared between threads
+    mutable FT_Library _library = nullptr;
+
+    /// @brief FreeType face, only opened when a glyph isn't baked
+    mutable FT_Face _face = nullptr;
+
+    /// @brief Guards loaded glyphs and face
+    mutable std::shared_mutex _mutex;
+
+    /// @brief Loaded glyphs, by codepoint (map nodes are stable, so references stay valid)
+    mutable std::unordered_map<uint32_t, Entry> _entries;
+
+    /// @brief Fast path for ASCII glyphs, pointing into entries map once loaded
+    mutable std::atomic<const Entry *> _ascii[128] = {};
+
+    /// @brief Advances of ASCII codepoints, kept apart from the rest of the metrics for measuring kernels
+    alignas(32) mutable float _advances[128];
+
+    /// @brief Fills advance table once, on first measure
+    mutable std::once_flag _advancesOnce;
+
+    /// @brief Baked kerning, by pair of codepoints (never modified after construction)
+    std::unordered_map<uint64_t, float> _kerning;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "glad/glad.h"
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+/// @brief OpenGL functions past the 3.3 core profile loaded by glad, loaded only if the driver has them
+namespace GLExtensions {
+
+/// @brief Loads extension functions, must be called after glad with the context current
+void load();
+
+/// @brief Whether program binaries can be read and loaded (GL 4.1 or GL_ARB_get_program_binary)
+/// @return whether programBinary functions are loaded and driver has at least one binary format
+bool hasProgramBinary();
+
+/// @brief Whether compile and link completion can be polled (GL_KHR or GL_ARB_parallel_shader_compile)
+/// @return whether GL_COMPLETION_STATUS_KHR can be queried
+bool hasParallelShaderCompile();
+
+/// @brief glGetProgramBinary, null if not supported
+extern void (APIENTRYP getProgramBinary)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+
+/// @brief glProgramBinary, null if not supported
+extern void (APIENTRYP programBinary)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+
+/// @brief glProgramParameteri, null if not supported
+extern void (APIENTRYP programParameteri)(GLuint program, GLenum pname, GLint value);
+
+/// @brief glMaxShaderCompilerThreadsKHR, null if not supported
+extern void (APIENTRYP maxShaderCompilerThreads)(GLuint count);
+
+} // GLExtensions
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+/// @brief Width and height in pixels of each atlas page texture
+#define GLYPH_ATLAS_PAGE_SIZE 1024
+
+/// @brief Texture atlas holding glyph bitmaps in fixed-size cells, spread over pages allocated on demand
+/// @note Once the memory budget is reached, new glyphs replace the least recently used ones
+class GlyphAtlas {
+public:
+    /// @brief Value returned for slots that don't exist
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    /// @brief Default constructor
+    GlyphAtlas() = default;
+
+    /// @brief Constructor
+    /// @param cellSize size in pixels of the biggest glyph bitmap to be stored
+    /// @param budget maximum texture memory in bytes (rounded down to whole pages, minimum one)
+    GlyphAtlas(const glm::ivec2 &cellSize, size_t budget);
+
+    /// @brief Whether the next insert replaces a stored glyph, as the atlas is full
+    /// @return whether inserting evicts the least recently used glyph
+    bool full() const;
+
+    /// @brief Stores a glyph bitmap, evicting the least recently used glyph if atlas is full
+    /// @param key identifier of the glyph (usually a codepoint)
+    /// @param bitmap 8-bit bitmap rows, top to bottom
+    /// @param width bitmap width in pixels (cropped to cell size)
+    /// @param rows bitmap height in pixels (cropped to cell size)
+    /// @param pitch bytes between bitmap rows
+    /// @return slot where glyph was stored
+    uint32_t insert(uint32_t key, const unsigned char *bitmap, int width, int rows, int pitch);
+
+    /// @brief Whether a slot still holds a given glyph, marking it as recently used if so
+    /// @param slot slot returned by insert
+    /// @param key identifier of the glyph
+    /// @return whether glyph is still stored in slot
+    bool acquire(uint32_t slot, uint32_t key);
+
+    /// @brief Get texture of the page holding a slot
+    /// @param slot slot index
+    /// @return OpenGL texture ID
+    unsigned int texture(uint32_t slot) const;
+
+    /// @brief Get glyph rectangle of a slot in page texture coordinates
+    /// @param slot slot index
+    /// @param size glyph bitmap size in pixels
+    /// @return offset (xy) and size (zw) in [0-1] range
+    glm::vec4 uvRect(uint32_t slot, const glm::vec2 &size) const;
+
+    /// @brief Get size of each cell
+    /// @return cell size in pixels
+    glm::ivec2 cellSize() const;
+
+    /// @brief Get maximum number of glyphs held at once
+    /// @return number of slots
+    uint32_t capacity() const;
+
+    /// @brief Get number of glyphs currently stored
+    /// @return number of used slots
+    uint32_t size() const;
+
+    /// @brief Frees page textures
+    void destroy();
+
+private:
+    /// @brief Allocates a new page texture
+    void addPage();
+
+    /// @brief Moves a slot to the front of the LRU list
+    /// @param slot slot index
+    void moveToFront(uint32_t slot);
+
+    /// @brief Removes a slot from the LRU list
+    /// @param slot slot index
+    void unlink(uint32_t slot);
+
+    /// @brief Size of each cell, including padding
+    glm::ivec2 _cellSize = glm::ivec2{0, 0};
+
+    /// @brief Number of cells in each page row
+    int _cellsPerRow = 0;
+
+    /// @brief Number of cells in each page
+    uint32_t _cellsPerPage = 0;
+
+    /// @brief Maximum number of pages allowed by budget
+    size_t _maxPages = 0;
+
+    /// @brief Page textures
+    std::vector<unsigned int> _pages;
+
+    /// @brief Key of glyph stored in each slot
+    std::vector<uint32_t> _keys;
+
+    /// @brief Previous (more recently used) slot in LRU list
+    std::vector<uint32_t> _prev;
+
+    /// @brief Next (less recently used) slot in LRU list
+    std::vector<uint32_t> _next;
+
+    /// @brief Most recently used slot
+    uint32_t _head = NO_SLOT;
+
+    /// @brief Least recently used slot
+    uint32_t _tail = NO_SLOT;
+};
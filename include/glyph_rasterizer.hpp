@@ -0,0 +1,139 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "font.hpp"
+#include "mapped_file.hpp"
+
+/// @brief Request for a glyph to be rasterized in background
+struct GlyphRequest {
+    /// @brief Identifier of the font requesting the glyph
+    uint64_t fontId;
+
+    /// @brief Mapped font file, shared with the font's own face
+    std::shared_ptr<const MappedFile> file;
+
+    /// @brief Font height in pixels
+    float fontHeight;
+
+    /// @brief How glyph is rasterized
+    GlyphRenderMode renderMode;
+
+    /// @brief Codepoint to rasterize
+    uint32_t codepoint;
+};
+
+/// @brief Glyph bitmap rasterized in background, waiting to be uploaded
+struct RasterizedGlyph {
+    /// @brief Identifier of the font that requested the glyph
+    uint64_t fontId;
+
+    /// @brief Rasterized codepoint
+    uint32_t codepoint;
+
+    /// @brief Whether rasterization succeeded
+    bool success;
+
+    /// @brief Tightly packed 8-bit bitmap rows, top to bottom
+    std::vector<unsigned char> bitmap;
+
+    /// @brief Bitmap size in pixels
+    glm::vec2 size;
+
+    /// @brief Offset from baseline to top-left of glyph
+    glm::vec2 bearing;
+
+    /// @brief Horizontal offset to advance to next glyph
+    float advance;
+};
+
+/// @brief Service rasterizing glyphs with FreeType on worker threads
+/// @note Each worker has its own FT_Library and faces, since FreeType objects can't be shared
+///       between threads (faces still read from the same mapped file). No OpenGL calls are made
+///       here, results are uploaded by the GL thread
+class GlyphRasterizer {
+public:
+    /// @brief Constructor, starts worker threads
+    /// @param numThreads number of worker threads (at least one)
+    GlyphRasterizer(unsigned int numThreads);
+
+    /// @brief Destructor, stops and joins worker threads
+    ~GlyphRasterizer();
+
+    GlyphRasterizer(const GlyphRasterizer &) = delete;
+    GlyphRasterizer &operator= (const GlyphRasterizer &) = delete;
+
+    /// @brief Queues a glyph to be rasterized
+    /// @param request glyph request
+    void request(GlyphRequest request);
+
+    /// @brief Moves finished glyphs to a list, without blocking on workers
+    /// @param out list to append glyphs to
+    /// @param max maximum number of glyphs to take
+    /// @return number of glyphs taken
+    size_t collect(std::vector<RasterizedGlyph> &out, size_t max);
+
+    /// @brief Whether there are finished glyphs to collect
+    /// @return whether collect would return something
+    bool hasResults() const;
+
+    /// @brief Tells workers a font won't request glyphs anymore, so they can close its faces
+    /// @param fontId font identifier
+    void release(uint64_t fontId);
+
+    /// @brief Get number of worker threads
+    /// @return number of threads
+    unsigned int numThreads() const;
+
+    /// @brief Loads and renders a glyph into the face glyph slot
+    /// @param face FreeType face, with pixel size already set
+    /// @param codepoint unicode codepoint
+    /// @param renderMode how glyph is rasterized
+    /// @return FreeType error code, 0 on success
+    static FT_Error renderGlyph(FT_Face face, uint32_t codepoint, GlyphRenderMode renderMode);
+
+    /// @brief Applies glyph rendering settings to a FreeType library
+    /// @param library FreeType library
+    static void setupLibrary(FT_Library library);
+
+private:
+    /// @brief Worker thread loop
+    void work();
+
+    /// @brief Worker threads
+    std::vector<std::thread> _threads;
+
+    /// @brief Mutex guarding requests, released fonts and stop flag
+    std::mutex _requestsMutex;
+
+    /// @brief Signals workers when there are requests or they should stop
+    std::condition_variable _requestsCondition;
+
+    /// @brief Pending requests
+    std::deque<GlyphRequest> _requests;
+
+    /// @brief Released fonts, in release order (each worker tracks how many it has handled)
+    std::vector<uint64_t> _released;
+
+    /// @brief Whether workers should stop
+    bool _stop = false;
+
+    /// @brief Mutex guarding results
+    std::mutex _resultsMutex;
+
+    /// @brief Finished glyphs
+    std::deque<RasterizedGlyph> _results;
+
+    /// @brief Number of finished glyphs, readable without locking
+    std::atomic<size_t> _numResults{0};
+};
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include "dim.hpp"
+
+/// @brief How a node places its children
+enum class LayoutDirection {
+    /// @brief Each child is placed on its own position and anchor point
+    none,
+
+    /// @brief Children are stacked left to right
+    row,
+
+    /// @brief Children are stacked top to bottom
+    column,
+};
+
+/// @brief How children are placed on the cross axis of a row or column
+enum class LayoutAlign {
+    start,
+    center,
+    end,
+
+    /// @brief Children fill the cross axis, ignoring their own size on it
+    stretch,
+};
+
+/// @brief How leftover space is distributed on the main axis of a row or column
+enum class LayoutJustify {
+    start,
+    center,
+    end,
+
+    /// @brief Leftover space goes between children
+    spaceBetween,
+};
+
+/// @brief Node of a flex/stack layout tree, resolving Dim sizes into pixel rectangles
+/// @note Only subtrees whose inputs changed are laid out again. Sizes never depend on children,
+///       so a change only reaches the node, its subtree and its siblings' placement.
+/// @note Children sizes and positions are kept by their parent as packed (pixels, scale) coefficients,
+///       resolved in one vectorized pass. On resize, children made only of pixels aren't visited
+///       unless a row or column (or scaled padding) moves them.
+/// @note Nodes are linked by address, so they can't be copied or moved
+class LayoutNode {
+public:
+    /// @brief Default constructor
+    LayoutNode() = default;
+
+    /// @brief Destructor, detaches node from its parent and children
+    ~LayoutNode();
+
+    LayoutNode(const LayoutNode &) = delete;
+    LayoutNode &operator= (const LayoutNode &) = delete;
+
+    /// @brief Set position, used when parent direction is none
+    /// @param position position relative to parent content box, scale is relative to its size
+    void setPosition(const Dim2 &position);
+
+    /// @brief Get position
+    /// @return position
+    Dim2 position() const;
+
+    /// @brief Set anchor point, used when parent direction is none
+    /// @param anchorPoint [0, 0] places position on the top left corner, [1, 1] on the bottom right one
+    void setAnchorPoint(const glm::vec2 &anchorPoint);
+
+    /// @brief Get anchor point
+    /// @return anchor point
+    glm::vec2 anchorPoint() const;
+
+    /// @brief Set size
+    /// @param size size, scale is relative to parent content box
+    void setSize(const Dim2 &size);
+
+    /// @brief Get size
+    /// @return size
+    Dim2 size() const;
+
+    /// @brief Set grow factor, share of leftover main axis space taken in a row or column
+    /// @param grow grow factor, 0 to keep own size
+    void setGrow(float grow);
+
+    /// @brief Get grow factor
+    /// @return grow factor
+    float grow() const;
+
+    /// @brief Set how children are placed
+    /// @param direction direction
+    void setDirection(LayoutDirection direction);
+
+    /// @brief Get how children are placed
+    /// @return direction
+    LayoutDirection direction() const;
+
+    /// @brief Set space between children of a row or column
+    /// @param gap gap, scale is relative to content box main axis
+    void setGap(const Dim &gap);
+
+    /// @brief Get space between children
+    /// @return gap
+    Dim gap() const;
+
+    /// @brief Set space between the node edges and its content box, on each side
+    /// @param padding padding, scale is relative to node size
+    void setPadding(const Dim2 &padding);
+
+    /// @brief Get padding
+    /// @return padding
+    Dim2 padding() const;
+
+    /// @brief Set cross axis alignment of children in a row or column
+    /// @param align alignment
+    void setAlignItems(LayoutAlign align);
+
+    /// @brief Get cross axis alignment of children
+    /// @return alignment
+    LayoutAlign alignItems() const;
+
+    /// @brief Set main axis distribution of leftover space in a row or column
+    /// @param justify distribution
+    void setJustifyContent(LayoutJustify justify);
+
+    /// @brief Get main axis distribution of leftover space
+    /// @return distribution
+    LayoutJustify justifyContent() const;
+
+    /// @brief Appends a child, detaching it from its previous parent
+    /// @param child child node
+    void addChild(LayoutNode *child);
+
+    /// @brief Removes a child
+    /// @param child child node, ignored if not a child of this node
+    void removeChild(LayoutNode *child);
+
+    /// @brief Get parent
+    /// @return parent node, null for roots
+    LayoutNode *parent() const;
+
+    /// @brief Get children
+    /// @return children, in placement order
+    const std::vector<LayoutNode *> &children() const;
+
+    /// @brief Lays out the tree rooted at this node, placed on its position inside a container
+    /// @param containerSize size of the container in pixels, usually the window
+    /// @return number of nodes laid out again, 0 if nothing changed
+    size_t update(const glm::vec2 &containerSize);
+
+    /// @brief Whether node or any descendant must be laid out again
+    /// @return whether update would do any work (for the same container size)
+    bool isDirty() const;
+
+    /// @brief Get top left corner, as of last update
+    /// @return position in pixels, relative to parent's top left corner (container's for roots)
+    glm::vec2 computedPosition() const;
+
+    /// @brief Get size, as of last update
+    /// @return size in pixels
+    glm::vec2 computedSize() const;
+
+private:
+    /// @brief Marks node inputs as changed, so it and its siblings are placed again
+    void markDirty();
+
+    /// @brief Marks how children are placed as changed, which doesn't affect this node's own rectangle
+    void markChildrenDirty();
+
+    /// @brief Marks node and its ancestors as having something to lay out below them
+    void markDescendantDirty();
+
+    /// @brief Resolves rectangle of a node placed on its own position
+    /// @param containerSize content box size of parent in pixels
+    /// @param size resolved size in pixels
+    /// @param topLeft resolved top left corner in pixels, relative to content box
+    void resolveAbsolute(const glm::vec2 &containerSize, glm::vec2 &size, glm::vec2 &topLeft) const;
+
+    /// @brief Assigns rectangle to node, laying out its subtree only where needed
+    /// @param size size in pixels
+    /// @param position top left corner in pixels, relative to parent
+    /// @param visited number of nodes laid out, incremented
+    void place(const glm::vec2 &size, const glm::vec2 &position, size_t &visited);
+
+    /// @brief Writes size and position coefficients into parent's packed arrays
+    void writeCoefficients();
+
+    /// @brief Resolves content box and every child's coefficients against it
+    /// @param padding resolved padding in pixels
+    /// @param content resolved content box size in pixels
+    void resolveChildren(glm::vec2 &padding, glm::vec2 &content);
+
+    /// @brief Computes and assigns rectangles of every child
+    /// @param visited number of nodes laid out, incremented
+    void arrangeChildren(size_t &visited);
+
+    /// @brief Whether a resize leaves children made only of pixels in place
+    /// @return true when children are placed on their own positions and padding is only pixels
+    bool resizeKeepsPixelChildren() const;
+
+    /// @brief Assigns rectangles of children depending on content box size, after a resize
+    /// @param visited number of nodes laid out, incremented
+    void arrangeScaledChildren(size_t &visited);
+
+    /// @brief Position
+    Dim2 _position;
+
+    /// @brief Anchor point
+    glm::vec2 _anchorPoint = glm::vec2{0.0f};
+
+    /// @brief Size
+    Dim2 _size;
+
+    /// @brief Grow factor
+    float _grow = 0.0f;
+
+    /// @brief Children placement
+    LayoutDirection _direction = LayoutDirection::none;
+
+    /// @brief Space between children
+    Dim _gap;
+
+    /// @brief Space between edges and content box
+    Dim2 _padding;
+
+    /// @brief Cross axis alignment of children
+    LayoutAlign _alignItems = LayoutAlign::start;
+
+    /// @brief Main axis distribution of leftover space
+    LayoutJustify _justifyContent = LayoutJustify::start;
+
+    /// @brief Parent, null for roots
+    LayoutNode *_parent = nullptr;
+
+    /// @brief Children
+    std::vector<LayoutNode *> _children;
+
+    /// @brief Index in parent's children and coefficient arrays
+    size_t _index = 0;
+
+    /// @brief Pixels of children sizes and positions, as (x, y) pairs: size then position of each child
+    std::vector<float> _childPixels;
+
+    /// @brief Scales of children sizes and positions, same layout as _childPixels
+    std::vector<float> _childScales;
+
+    /// @brief Children sizes and positions resolved by last arrangement, same layout as _childPixels
+    std::vector<float> _childResolved;
+
+    /// @brief Indices of children whose size or position has a scale
+    std::vector<size_t> _scaledChildren;
+
+    /// @brief Whether _scaledChildren must be rebuilt
+    bool _scaledChildrenStale = true;
+
+    /// @brief Container size of last update, for roots
+    glm::vec2 _containerSize = glm::vec2{-1.0f};
+
+    /// @brief Computed top left corner
+    glm::vec2 _computedPosition = glm::vec2{0.0f};
+
+    /// @brief Computed size, negative until first placed
+    glm::vec2 _computedSize = glm::vec2{-1.0f};
+
+    /// @brief Whether own inputs changed since last update
+    bool _dirty = true;
+
+    /// @brief Whether children were added, removed or changed since last update
+    bool _childrenDirty = false;
+
+    /// @brief Whether some descendant must be laid out (implies the same for every ancestor)
+    bool _descendantDirty = false;
+};
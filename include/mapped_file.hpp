@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/// @brief Read-only view of a whole file, memory-mapped where supported
+class MappedFile {
+public:
+    /// @brief Default constructor, no file open
+    MappedFile() = default;
+
+    /// @brief Constructor, opens a file
+    /// @param path path to file
+    MappedFile(const std::string &path);
+
+    /// @brief Destructor, unmaps file
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator= (const MappedFile &) = delete;
+
+    /// @brief Move constructor
+    MappedFile(MappedFile &&other) noexcept;
+
+    /// @brief Move assignment
+    MappedFile &operator= (MappedFile &&other) noexcept;
+
+    /// @brief Opens a file, closing the previous one
+    /// @param path path to file
+    /// @return whether was successful or not
+    bool open(const std::string &path);
+
+    /// @brief Views bytes owned elsewhere as if they were a file, closing the previous one
+    /// @param data first byte, must outlive this object
+    /// @param size size in bytes
+    void view(const unsigned char *data, size_t size);
+
+    /// @brief Unmaps file
+    void close();
+
+    /// @brief Whether a file is open
+    /// @return whether a file is open
+    bool isOpen() const;
+
+    /// @brief Get file contents
+    /// @return pointer to first byte, null if no file is open
+    const unsigned char *data() const;
+
+    /// @brief Get file size
+    /// @return size in bytes
+    size_t size() const;
+
+private:
+    /// @brief Mapped bytes
+    const unsigned char *_data = nullptr;
+
+    /// @brief File size in bytes
+    size_t _size = 0;
+
+    /// @brief Whether a file is open
+    bool _open = false;
+
+    /// @brief Whether data was mapped (otherwise it points into fallback buffer)
+    bool _mapped = false;
+
+    /// @brief Whether data is owned elsewhere (see view)
+    bool _borrowed = false;
+
+    /// @brief File contents, for empty files or platforms without mmap
+    std::vector<unsigned char> _buffer;
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <new>
+
+#include "debug.hpp"
+
+/// @brief Generational index of a node in a NodePool
+/// @tparam T node type
+/// @note Slots are reused, the generation tells a live node from a destroyed one in the same slot
+template <typename T>
+struct NodeHandle {
+    /// @brief Slot index, INVALID_INDEX for null handles
+    uint32_t index = INVALID_INDEX;
+
+    /// @brief Generation of the slot when the node was created
+    uint32_t generation = 0;
+
+    /// @brief Index of null handles
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    /// @brief Whether handle was ever assigned a node (which may be destroyed by now)
+    /// @return false for default constructed handles
+    constexpr bool isNull() const {
+        return index == INVALID_INDEX;
+    }
+
+    constexpr bool operator== (const NodeHandle &h) const {
+        return index == h.index && generation == h.generation;
+    }
+
+    constexpr bool operator!= (const NodeHandle &h) const {
+        return !(*this == h);
+    }
+};
+
+/// @brief Pool of nodes stored in fixed pages, with free lists and generational handles
+/// @tparam T node type
+/// @note Pages are never moved or freed until the pool is, so node addresses stay stable.
+///       Creating and destroying is O(1) and doesn't allocate once enough pages exist
+template <typename T>
+class NodePool {
+public:
+    /// @brief Nodes per page
+    static constexpr uint32_t PAGE_SIZE = 256;
+
+    /// @brief Default constructor
+    NodePool() = default;
+
+    /// @brief Destructor, destroys every live node
+    ~NodePool() {
+        clear();
+    }
+
+    NodePool(const NodePool &) = delete;
+    NodePool &operator= (const NodePool &) = delete;
+
+    /// @brief Constructs a node in a free slot
+    /// @param ...args constructor arguments
+    /// @return handle to the new node
+    template <typename... Args>
+    NodeHandle<T> create(Args &&...args) {
+        if (_freeHead == NodeHandle<T>::INVALID_INDEX) addPage();
+
+        const uint32_t index = _freeHead;
+        Slot &s = slot(index);
+        _freeHead = s.nextFree;
+
+        new (s.storage) T(std::forward<Args>(args)...);
+        s.alive = true;
+        ++_size;
+        return NodeHandle<T>{index, s.generation};
+    }
+
+    /// @brief Destroys a node, freeing its slot for reuse
+    /// @param handle node handle, ignored if stale
+    void destroy(NodeHandle<T> handle) {
+        if (!isValid(handle)) {
+            warnStale(handle);
+            return;
+        }
+
+        Slot &s = slot(handle.index);
+        reinterpret_cast<T *>(s.storage)->~T();
+        s.alive = false;
+
+        // Handles to this node are stale from now on
+        ++s.generation;
+        s.nextFree = _freeHead;
+        _freeHead = handle.index;
+        --_size;
+    }
+
+    /// @brief Whether a handle points to a live node
+    /// @param handle node handle
+    /// @return whether node exists and wasn't destroyed
+    bool isValid(NodeHandle<T> handle) const {
+        if (handle.index >= _pages.size() * PAGE_SIZE) return false;
+        const Slot &s = slot(handle.index);
+        return s.alive && s.generation == handle.generation;
+    }
+
+    /// @brief Gets a node
+    /// @param handle node handle
+    /// @return node, null if the handle is stale (which is reported on DEBUG builds)
+    T *get(NodeHandle<T> handle) const {
+        if (!isValid(handle)) {
+            warnStale(handle);
+            return nullptr;
+        }
+        return reinterpret_cast<T *>(slot(handle.index).storage);
+    }
+
+    /// @brief Destroys every live node, keeping pages for reuse
+    void clear() {
+        for (uint32_t i = 0; i < _pages.size() * PAGE_SIZE; ++i) {
+            Slot &s = slot(i);
+            if (s.alive) destroy(NodeHandle<T>{i, s.generation});
+        }
+    }
+
+    /// @brief Get number of live nodes
+    /// @return number of nodes
+    size_t size() const {
+        return _size;
+    }
+
+    /// @brief Get number of slots, live or free
+    /// @return number of slots
+    size_t capacity() const {
+        return _pages.size() * PAGE_SIZE;
+    }
+
+private:
+    /// @brief Storage of a node and its bookkeeping
+    struct Slot {
+        /// @brief Node storage, constructed while alive
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        /// @brief Generation, incremented every time the node in this slot is destroyed
+        uint32_t generation = 0;
+
+        /// @brief Next free slot, while free
+        uint32_t nextFree = NodeHandle<T>::INVALID_INDEX;
+
+        /// @brief Whether storage holds a node
+        bool alive = false;
+    };
+
+    /// @brief Gets slot by index
+    Slot &slot(uint32_t index) const {
+        return _pages[index / PAGE_SIZE][index % PAGE_SIZE];
+    }
+
+    /// @brief Adds a page, its slots going to the free list in index order
+    void addPage() {
+        const uint32_t first = (uint32_t)(_pages.size() * PAGE_SIZE);
+        _pages.push_back(std::make_unique<Slot[]>(PAGE_SIZE));
+        for (uint32_t i = PAGE_SIZE; i-- > 0;) {
+            _pages.back()[i].nextFree = _freeHead;
+            _freeHead = first + i;
+        }
+    }
+
+    /// @brief Reports use of a stale or null handle, on DEBUG builds
+    void warnStale([[maybe_unused]] NodeHandle<T> handle) const {
+        if (handle.isNull()) return;
+        debugPrint("Stale node handle (index %u, generation %u)\n", handle.index, handle.generation);
+    }
+
+    /// @brief Pages of slots
+    std::vector<std::unique_ptr<Slot[]>> _pages;
+
+    /// @brief First free slot, INVALID_INDEX if every slot is taken
+    uint32_t _freeHead = NodeHandle<T>::INVALID_INDEX;
+
+    /// @brief Number of live nodes
+    size_t _size = 0;
+};
@@ -1,20 +1,25 @@
 #pragma once
 
 #include <vector>
-#include <memory>
 
 #include "shader.hpp"
 #include "border_radius.hpp"
 #include "dim.hpp"
+#include "layout.hpp"
+#include "node_pool.hpp"
+
+class Quad;
+
+/// @brief Handle to a Quad in the quad pool
+using QuadHandle = NodeHandle<Quad>;
 
 /// @brief Namespace for quad module
 namespace QuadModule {
 
 /// @brief Attempts to initialize resources related to quad rendering
-/// @param rootPath path to project root
 /// @param windowSize initial window size
 /// @return whether was successful or not
-bool init(const std::string &rootPath, const glm::vec2 &windowSize);
+bool init(const glm::vec2 &windowSize);
 
 /// @brief Terminates/frees resources related to quad rendering
 void terminate();
@@ -23,20 +28,44 @@ void terminate();
 /// @param windowSize new window size in pixels
 void onWindowResize(const glm::vec2 &windowSize);
 
+/// @brief Creates a quad in the quad pool
+/// @return handle to the new quad
+QuadHandle create();
+
+/// @brief Destroys a quad and its children, detaching it from its parent
+/// @param handle quad handle, ignored if stale
+void destroy(QuadHandle handle);
+
+/// @brief Whether a handle points to a live quad
+/// @param handle quad handle
+/// @return whether quad exists and wasn't destroyed
+bool isValid(QuadHandle handle);
+
+/// @brief Gets a quad
+/// @param handle quad handle
+/// @return quad, null if the handle is stale. Addresses are stable until the quad is destroyed
+Quad *get(QuadHandle handle);
+
+/// @brief Get number of live quads in the pool
+/// @return number of quads
+size_t count();
+
 } // QuadModule
 
 /// @brief Class to represent a rectangular UI element
+/// @note Quads form a layout tree (see LayoutNode), so they can't be copied.
+///       They live in the quad pool and are referred to by QuadHandle (see QuadModule::create)
 class Quad {
 public:
     /// @brief Default constructor
-    Quad() = default;
+    Quad();
 
     /// @brief Constructor with window size
     /// @param windowSize current window size
     Quad(const glm::vec2 &windowSize);
 
-    /// @brief Set new position
-    /// @param pos position vector
+    /// @brief Set new position, used when parent layout direction is none
+    /// @param pos position vector, scale is relative to parent content box (window for roots)
     void setPosition(const Dim2 &pos);
 
     /// @brief Get position
@@ -53,7 +82,7 @@ public:
     glm::vec2 anchorPoint() const;
 
     /// @brief Set new size
-    /// @param size size vector
+    /// @param size size vector, scale is relative to parent content box (window for roots)
     void setSize(const Dim2 &size);
 
     /// @brief Get size
@@ -84,42 +113,79 @@ public:
     /// @return border radius
     BorderRadius borderRadius() const;
 
-    /// @brief Adds a new child to this Quad
-    /// @param child new child
-    void addChild(const std::shared_ptr<Quad> &child);
+    /// @brief Adds a new child to this Quad, laid out inside its content box
+    /// @param child new child, detached from its previous parent quad
+    void addChild(QuadHandle child);
+
+    /// @brief Removes a child, which isn't destroyed
+    /// @param child child, ignored if not a child of this quad
+    void removeChild(QuadHandle child);
+
+    /// @brief Get children
+    /// @return children, in drawing order
+    const std::vector<QuadHandle> &children() const;
+
+    /// @brief Get parent quad
+    /// @return parent, null for top level quads
+    Quad *parent() const;
+
+    /// @brief Gets layout node, to set how children are placed (direction, gap, padding, alignment)
+    /// @return layout node
+    LayoutNode &layout();
+
+    /// @brief Gets layout node
+    /// @return layout node
+    const LayoutNode &layout() const;
 
     /// @brief Callback for when window is resized
     void onWindowResize(const glm::vec2 &windowSize);
 
-    /// @brief Draws the quad
+    /// @brief Draws the quad, laying out its tree first if it's a root
     /// @param windowSize window size in pixels
-    /// @param model model matrix, used in recursive children rendering
+    /// @param parentTransform transform of parent's top left corner
     void draw(
         const glm::vec2 &windowSize,
-        const glm::mat4 &model = glm::mat4{1.0f}
+        const glm::mat4 &parentTransform = glm::mat4{1.0f}
     );
 
 private:
-    /// @brief Sets needed uniforms on shader to draw the quad
+    friend void QuadModule::destroy(QuadHandle handle);
+
+    /// @brief Draws the quad and its children, updating transforms that changed since last frame
     /// @param windowSize window size in pixels
-    /// @param model model matrix
-    void setUniforms(
+    /// @param parentTransform transform of parent's top left corner
+    /// @param parentVersion version of parentTransform, 0 for roots
+    void draw(
         const glm::vec2 &windowSize,
-        const glm::mat4 &model
+        const glm::mat4 &parentTransform,
+        uint64_t parentVersion
     );
 
-    /// @brief Calculates model matrix and stores for cached data
-    void calculateModelMatrix();
-
-    /// @brief Position
-    Dim2 _pos;
-
-    /// @brief Anchor point
-    /// @note [0, 0] means _pos is taken as bottom left, [0.5, 0.5] as center and [1, 1] as top right
-    glm::vec2 _anchorPoint = glm::vec2{0.5f};
+    /// @brief Resolves corner radii relative to the quad size, with overlapping radii scaled down
+    /// @param quadPixelsSize quad size in pixels
+    /// @param borderTL top left radius output, in [0, 1]
+    /// @param borderTR top right radius output, in [0, 1]
+    /// @param borderBL bottom left radius output, in [0, 1]
+    /// @param borderBR bottom right radius output, in [0, 1]
+    void normalizedCorners(
+        const glm::vec2 &quadPixelsSize,
+        glm::vec2 &borderTL,
+        glm::vec2 &borderTR,
+        glm::vec2 &borderBL,
+        glm::vec2 &borderBR
+    ) const;
+
+    /// @brief Picks shader variant for the quad corners and sets its uniforms, leaving it in use
+    /// @param model model matrix
+    /// @param quadPixelsSize quad size in pixels
+    void setUniforms(
+        const glm::mat4 &model,
+        const glm::vec2 &quadPixelsSize
+    );
 
-    /// @brief Size
-    Dim2 _size;
+    /// @brief Layout node, holding position, size and anchor point
+    /// @note Anchor point [0, 0] means position is taken as top left, [0.5, 0.5] as center and [1, 1] as bottom right
+    LayoutNode _layout;
 
     /// @brief Rotation in radians
     float _rotation = 0.0f;
@@ -130,12 +196,27 @@ private:
     /// @brief Border radius
     BorderRadius _borderRadius;
 
-    /// @brief Model matrix
-    glm::mat4 _modelMatrix = glm::mat4{1.0f};
+    /// @brief List of children
+    std::vector<QuadHandle> _children;
 
-    /// @brief Last known window size
-    glm::vec2 _lastWindowSize;
+    /// @brief Parent quad, null for roots
+    Quad *_parent = nullptr;
 
-    /// @brief List of children
-    std::vector<std::shared_ptr<Quad>> children;
+    /// @brief Transform of top left corner as of last draw, parent transform of children
+    glm::mat4 _transform{1.0f};
+
+    /// @brief Model matrix as of last draw
+    glm::mat4 _model{1.0f};
+
+    /// @brief Rectangle the transforms were computed from
+    glm::vec2 _transformPosition{0.0f}, _transformSize{-1.0f};
+
+    /// @brief Version of _transform, changes every time it's computed again
+    uint64_t _transformVersion = 0;
+
+    /// @brief Version of parent transform _transform was computed from
+    uint64_t _parentVersion = 0;
+
+    /// @brief Whether rotation changed since transforms were computed
+    bool _transformDirty = true;
 };
\ No newline at end of file
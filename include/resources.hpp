@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include "mapped_file.hpp"
+
+/// @brief Namespace for resources (shaders and optionally fonts) embedded in the library at build time
+/// @note Files in the override directory take precedence, so they can be edited without rebuilding
+namespace Resources {
+
+/// @brief Resource compiled into the library
+struct Embedded {
+    /// @brief Path relative to the resources directory, like "shaders/quad.vs"
+    const char *name;
+
+    /// @brief Contents
+    const unsigned char *data;
+
+    /// @brief Size in bytes
+    size_t size;
+};
+
+/// @brief Sets directory searched before embedded resources
+/// @param directory path to a resources directory, empty to only use embedded resources
+void setOverrideDirectory(const std::string &directory);
+
+/// @brief Gets directory searched before embedded resources
+/// @return path to directory, empty if not set
+std::string overrideDirectory();
+
+/// @brief Opens a resource, without copying embedded ones
+/// @param name path relative to the resources directory, like "shaders/quad.vs"
+/// @return view of its contents, null if neither the override directory nor the library has it
+std::shared_ptr<const MappedFile> open(const std::string &name);
+
+/// @brief Whether a resource is embedded in the library
+/// @param name path relative to the resources directory
+/// @return whether it's embedded
+bool isEmbedded(const std::string &name);
+
+/// @brief Gets names of every embedded resource
+/// @return names, sorted
+std::vector<std::string> embedded();
+
+} // Resources
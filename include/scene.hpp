@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "quad.hpp"
+#include "layout.hpp"
+
+/// @brief Root of the Quad tree, filling the window and drawing nothing itself
+/// @note Owned by Application, which forwards window resizes to it. Thanks to LayoutNode,
+///       a resize only reaches quads whose size or position depends on the window
+class Scene {
+public:
+    /// @brief Default constructor
+    Scene();
+
+    Scene(const Scene &) = delete;
+    Scene &operator= (const Scene &) = delete;
+
+    /// @brief Adds a new top level quad, laid out inside the window
+    /// @param child new child, detached from its parent quad if any
+    void addChild(QuadHandle child);
+
+    /// @brief Removes a top level quad, which isn't destroyed
+    /// @param child child, ignored if not in the scene
+    void removeChild(QuadHandle child);
+
+    /// @brief Get top level quads
+    /// @return quads, in drawing order. May hold destroyed quads until next draw
+    const std::vector<QuadHandle> &children() const;
+
+    /// @brief Gets layout node, to set how top level quads are placed
+    /// @return layout node
+    LayoutNode &layout();
+
+    /// @brief Callback for window resize, lays out quads depending on the window size again
+    /// @param windowSize new window size in pixels
+    void onWindowResize(const glm::vec2 &windowSize);
+
+    /// @brief Lays out what changed since last frame and draws every quad
+    /// @param windowSize window size in pixels
+    void draw(const glm::vec2 &windowSize);
+
+private:
+    /// @brief Layout node, sized as the window
+    LayoutNode _layout;
+
+    /// @brief Top level quads
+    std::vector<QuadHandle> _children;
+};
@@ -4,6 +4,7 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <vector>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -16,12 +17,24 @@ public:
     /// @brief Default constructor
     Shader() = default;
 
-    /// @brief Constructor with file paths
-    /// @param vertexPath path to vertex shader
-    /// @param fragmentPath path to fragment shader
-    Shader(const std::string &vertexPath, const std::string &fragmentPath);
+    /// @brief Constructor with resource names (see Resources), or file paths if no resource has that name
+    /// @note Compilation is only submitted, its result is checked on first use or finish
+    /// @param vertexPath vertex shader name, like "shaders/quad.vs"
+    /// @param fragmentPath fragment shader name, like "shaders/quad.fs"
+    /// @param defines macros defined in both stages, right after their #version line
+    Shader(const std::string &vertexPath, const std::string &fragmentPath, const std::vector<std::string> &defines = {});
 
-    /// @brief Use/activate shader
+    /// @brief Whether compilation finished, so using the shader won't stall
+    /// @return whether shader is ready, always true if the driver can't tell (no parallel shader compile)
+    bool isReady() const;
+
+    /// @brief Waits for compilation, printing errors if any
+    void finish() const;
+
+    /// @brief Waits for compilation of every shader created so far
+    static void finishAll();
+
+    /// @brief Use/activate shader, waiting for compilation if needed
     void use() const;
 
     /// @brief Destroy shader
@@ -62,6 +75,14 @@ public:
     /// @param value mat4
     void setMat4(const std::string &name, const glm::mat4 &value) const;
 
+    /// @brief Whether program was loaded from the program binary cache
+    /// @return whether it skipped compilation
+    bool fromCache() const;
+
     /// @brief OpenGL identifier
     unsigned int id;
+
+private:
+    /// @brief Whether program was loaded from the program binary cache
+    bool _fromCache = false;
 };
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/// @brief On-disk cache of linked program binaries, so shaders aren't compiled on every launch
+/// @note Only used if the driver supports program binaries (see GLExtensions::hasProgramBinary)
+namespace ShaderCache {
+
+/// @brief Sets directory where program binaries are stored, creating it if needed
+/// @param directory path to directory, empty to disable cache
+void setDirectory(const std::string &directory);
+
+/// @brief Gets directory where program binaries are stored
+/// @return path to directory, empty if cache is disabled
+std::string directory();
+
+/// @brief Whether programs are cached, which needs a directory and driver support
+/// @return whether cache is enabled
+bool enabled();
+
+/// @brief Computes cache key of a program
+/// @param vertexCode vertex shader source, as compiled (with any defines already in it)
+/// @param fragmentCode fragment shader source, as compiled (with any defines already in it)
+/// @return hash of both sources and the driver vendor, renderer and version strings
+uint64_t key(const std::string &vertexCode, const std::string &fragmentCode);
+
+/// @brief Creates a program from a cached binary
+/// @param key program key
+/// @return program ID, 0 if there's no binary or the driver rejected it (its file is then removed)
+unsigned int load(uint64_t key);
+
+/// @brief Tells the driver a program binary will be retrieved, must be called before linking
+/// @param program program ID
+void prepare(unsigned int program);
+
+/// @brief Stores binary of a linked program
+/// @param key program key
+/// @param program program ID
+void store(uint64_t key, unsigned int program);
+
+/// @brief Gets number of programs loaded from cache
+/// @return number of hits
+size_t hits();
+
+/// @brief Gets number of programs that had to be compiled
+/// @return number of misses
+size_t misses();
+
+} // ShaderCache
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include "shader.hpp"
+
+/// @brief Set of compile-time specializations of one shader, selected by a feature bitmask
+/// @note Bit i of a key defines the i-th feature name, variants are compiled on first use and kept
+class ShaderVariants {
+public:
+    /// @brief Default constructor
+    ShaderVariants() = default;
+
+    /// @brief Constructor with file paths and feature names
+    /// @param vertexPath path to vertex shader
+    /// @param fragmentPath path to fragment shader
+    /// @param features macro name of each key bit, at most 32
+    /// @param setup called on each variant on its first get, to set uniforms shared by all of them
+    ShaderVariants(
+        const std::string &vertexPath,
+        const std::string &fragmentPath,
+        const std::vector<std::string> &features,
+        const std::function<void(const Shader &)> &setup = nullptr
+    );
+
+    /// @brief Submits a variant for compilation ahead of its first use, without waiting for it
+    /// @param key feature bitmask
+    void prepare(uint32_t key);
+
+    /// @brief Gets a variant, compiling it if needed
+    /// @param key feature bitmask
+    /// @return shader with the features of set bits defined, set up and ready to use
+    const Shader &get(uint32_t key);
+
+    /// @brief Calls a function on every variant already returned by get
+    /// @param function function to call
+    void forEach(const std::function<void(const Shader &)> &function) const;
+
+    /// @brief Gets number of compiled variants
+    /// @return number of variants
+    size_t size() const;
+
+    /// @brief Destroys all compiled variants
+    void destroy();
+
+private:
+    /// @brief Path to vertex shader
+    std::string _vertexPath;
+
+    /// @brief Path to fragment shader
+    std::string _fragmentPath;
+
+    /// @brief Macro name of each key bit
+    std::vector<std::string> _features;
+
+    /// @brief Called on each variant on its first get
+    std::function<void(const Shader &)> _setup;
+
+    /// @brief Compiled variant
+    struct Variant {
+        /// @brief Shader with the variant features defined
+        Shader shader;
+
+        /// @brief Whether setup was called, which waits for compilation
+        bool setUp = false;
+    };
+
+    /// @brief Variants by key
+    std::unordered_map<uint32_t, Variant> _variants;
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include "text_buffer.hpp"
+
+/// @brief Default maximum memory held by the shaped run cache, in bytes
+#define DEFAULT_SHAPED_RUN_CACHE_SIZE (4 * 1024 * 1024)
+
+/// @brief Glyph placed by text layout
+struct PlacedGlyph {
+    /// @brief Unicode codepoint
+    uint32_t codepoint;
+
+    /// @brief Glyph origin on the baseline, in pixels relative to the text top-left
+    glm::vec2 baseline;
+};
+
+/// @brief Line produced by text layout
+struct ShapedLine {
+    /// @brief Byte index on the text at which the line starts
+    size_t startIdx;
+
+    /// @brief Byte index on the text at which the line ends
+    size_t endIdx;
+
+    /// @brief Index of the first glyph of the line in ShapedRun::glyphs
+    size_t firstGlyph;
+
+    /// @brief Line box as top-left (xy) and size (zw), in pixels relative to the text top-left
+    glm::vec4 bounds;
+};
+
+/// @brief Result of laying out a text, independent of where it is drawn
+struct ShapedRun {
+    /// @brief Lines, in order
+    std::vector<ShapedLine> lines;
+
+    /// @brief Visible glyphs, in order (spaces are left out)
+    std::vector<PlacedGlyph> glyphs;
+
+    /// @brief Box around every line as top-left (xy) and size (zw), in pixels relative to the text top-left
+    glm::vec4 bounds = glm::vec4{0.0f};
+
+    /// @brief Get memory held by the run
+    /// @return size in bytes
+    size_t memoryUsage() const;
+};
+
+/// @brief Everything a shaped run depends on, besides the text itself
+struct ShapedRunKey {
+    /// @brief Hash of the text contents
+    uint64_t textHash;
+
+    /// @brief Text size in bytes, to make hash collisions less likely
+    size_t textSize;
+
+    /// @brief Identifier of the font (Font::id)
+    uint64_t fontId;
+
+    /// @brief Font size in pixels
+    float fontSize;
+
+    /// @brief Render width in pixels
+    float renderWidth;
+
+    /// @brief Text alignment (TextAlignment)
+    uint32_t alignment;
+
+    /// @brief Line height in font size scale
+    float lineHeight;
+
+    bool operator== (const ShapedRunKey &other) const;
+};
+
+/// @brief Hash functor for shaped run keys
+struct ShapedRunKeyHash {
+    size_t operator() (const ShapedRunKey &key) const;
+};
+
+/// @brief Process-wide cache of shaped runs, so texts with identical inputs share one layout
+/// @note Must only be used from the thread that draws text
+namespace ShapedRunCache {
+
+/// @brief Looks up a shaped run, marking it as recently used
+/// @param key layout inputs
+/// @param text laid out text, compared with the cached one so hash collisions never hit
+/// @return shared run, null if not cached
+std::shared_ptr<const ShapedRun> find(const ShapedRunKey &key, const TextBuffer &text);
+
+/// @brief Adds a shaped run, evicting least recently used runs over the memory cap
+/// @param key layout inputs
+/// @param text laid out text, a snapshot is kept with the run
+/// @param run shaped run
+/// @return shared run (the already cached one if key and text were present)
+std::shared_ptr<const ShapedRun> insert(const ShapedRunKey &key, const TextBuffer &text, ShapedRun &&run);
+
+/// @brief Sets maximum memory held by the cache, evicting runs if needed
+/// @param maxMemory cap in bytes (0 disables caching)
+/// @note Evicted runs stay alive while texts still use them
+void setMaxMemory(size_t maxMemory);
+
+/// @brief Gets maximum memory held by the cache
+/// @return cap in bytes
+size_t maxMemory();
+
+/// @brief Gets memory currently held by cached runs
+/// @return size in bytes
+size_t memoryUsage();
+
+/// @brief Gets number of cached runs
+/// @return number of runs
+size_t size();
+
+/// @brief Gets number of lookups that found a run since last reset
+/// @return number of hits
+size_t hits();
+
+/// @brief Gets number of lookups that didn't find a run since last reset
+/// @return number of misses
+size_t misses();
+
+/// @brief Resets hit and miss counters
+void resetStats();
+
+/// @brief Removes all cached runs
+void clear();
+
+} // ShapedRunCache
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <cstdint>
+#include <cstddef>
+
+/// @brief Fixed set of worker threads running parallel loops
+/// @note Loops are run one at a time, and the calling thread takes part in them
+class TaskPool {
+public:
+    /// @brief Constructor, starts worker threads
+    /// @param numThreads number of worker threads (at least one)
+    TaskPool(unsigned int numThreads);
+
+    /// @brief Destructor, stops and joins worker threads
+    ~TaskPool();
+
+    TaskPool(const TaskPool &) = delete;
+    TaskPool &operator= (const TaskPool &) = delete;
+
+    /// @brief Calls a function for every index in [0, count), spreading indices over all threads
+    /// @param count number of indices
+    /// @param task function called with each index, from any thread
+    /// @note Blocks until every index is done. If a call throws, the first exception is rethrown here
+    void parallelFor(size_t count, const std::function<void(size_t)> &task);
+
+    /// @brief Get number of worker threads
+    /// @return number of threads
+    unsigned int numThreads() const;
+
+private:
+    /// @brief Worker thread loop
+    void work();
+
+    /// @brief Runs indices of current loop until there are none left
+    /// @param task loop function
+    /// @param count number of indices
+    void runTasks(const std::function<void(size_t)> &task, size_t count);
+
+    /// @brief Worker threads
+    std::vector<std::thread> _threads;
+
+    /// @brief Mutex guarding loop state and stop flag
+    std::mutex _mutex;
+
+    /// @brief Signals workers when a loop starts or they should stop
+    std::condition_variable _startCondition;
+
+    /// @brief Signals calling thread when every worker is done with the loop
+    std::condition_variable _doneCondition;
+
+    /// @brief Current loop function
+    const std::function<void(size_t)> *_task = nullptr;
+
+    /// @brief Number of indices of current loop
+    size_t _count = 0;
+
+    /// @brief Next index to run
+    std::atomic<size_t> _next{0};
+
+    /// @brief Increased on every loop, so workers know when there's a new one
+    uint64_t _generation = 0;
+
+    /// @brief Number of workers done with current loop
+    size_t _numDone = 0;
+
+    /// @brief First exception thrown by current loop
+    std::exception_ptr _error;
+
+    /// @brief Whether workers should stop
+    bool _stop = false;
+};
@@ -1,19 +1,21 @@
 #pragma once
 
 #include <string>
+#include <memory>
 
 #include <glm/glm.hpp>
 
 #include "font.hpp"
+#include "shaped_run.hpp"
+#include "text_buffer.hpp"
+#include "text_layout.hpp"
 
 /// @brief Namespace for text module
 namespace TextModule {
 
 /// @brief Attempts to initialize resources related to text rendering
-/// @param rootPath path to project root
-/// @param windowSize initial window size
 /// @return whether was successful or not
-bool init(const std::string &rootPath, const glm::vec2 &windowSize);
+bool init();
 
 /// @brief Terminates/frees resources related to text rendering
 void terminate();
@@ -22,22 +24,39 @@ void terminate();
 /// @param windowSize new window size in pixels
 void onWindowResize(const glm::vec2 &windowSize);
 
-} // TextModule
-
-/// @brief Enum for different types of text alignment
-enum class TextAlignment {
-    /// @brief Aligned to left
-    left,
-
-    /// @brief Aligned to right
-    right,
+/// @brief Prepares text shader and buffers for drawing glyphs, uploading glyphs rasterized in background
+/// @param windowSize window size vector in pixels
+/// @param color glyphs color
+/// @param renderMode how glyphs to be drawn were rasterized, to pick the matching shader
+/// @param outlineWidth outline width in font loaded pixels (only for signed distance field glyphs)
+/// @param outlineColor outline color (only for signed distance field glyphs)
+/// @note While BatchModule is recording, glyphs are submitted to the batch instead of drawn
+void beginGlyphs(
+    const glm::vec2 &windowSize,
+    const glm::vec4 &color,
+    GlyphRenderMode renderMode = GlyphRenderMode::bitmap,
+    float outlineWidth = 0.0f,
+    const glm::vec4 &outlineColor = glm::vec4{0.0f}
+);
+
+/// @brief Draws a single glyph, must be called between beginGlyphs and endGlyphs
+/// @param character glyph data (skipped if it has no texture yet)
+/// @param baseline glyph origin on the text baseline, in pixels
+/// @param scale glyph scale relative to the font loaded height
+void drawGlyph(const Character &character, const glm::vec2 &baseline, float scale);
+
+/// @brief Unbinds resources bound by beginGlyphs
+void endGlyphs();
+
+/// @brief Sets number of worker threads laying out texts in Text::layoutBatch
+/// @param numThreads number of threads, 0 to lay out on the calling thread
+void setLayoutThreads(unsigned int numThreads);
+
+/// @brief Gets number of worker threads laying out texts in Text::layoutBatch
+/// @return number of threads, 0 if disabled
+unsigned int layoutThreads();
 
-    /// @brief Aligned to center
-    center,
-
-    /// @brief Justified
-    justified
-};
+} // TextModule
 
 /// @brief Class representing a text to be rendered on the screen
 class Text {
@@ -50,6 +69,11 @@ public:
     /// @param font font to be used
     Text(const std::string &text, const Font &font);
 
+    /// @brief Constructor with text buffer
+    /// @param text text buffer to display
+    /// @param font font to be used
+    Text(const TextBuffer &text, const Font &font);
+
     /// @brief Draws the quad
     /// @param windowSize window size vector in pixels
     void draw(const glm::vec2 &windowSize);
@@ -58,16 +82,24 @@ public:
     /// @param text text
     void setText(const std::string &text);
 
+    /// @brief Set new text from a buffer
+    /// @param text text buffer (only a snapshot is kept, so this is O(1))
+    void setText(const TextBuffer &text);
+
     /// @brief Get text
     /// @return text
     std::string text() const;
 
+    /// @brief Get text buffer
+    /// @return text buffer
+    const TextBuffer &buffer() const;
+
     /// @brief Set new font
     /// @param font font
     void setFont(const Font &font);
 
     /// @brief Get font
-    /// @return font
+    /// @return font handle, sharing glyphs with this one
     Font font() const;
 
     /// @brief Set new font size
@@ -110,6 +142,19 @@ public:
     /// @return color
     glm::vec4 color() const;
 
+    /// @brief Set new outline, only drawn with signed distance field fonts
+    /// @param width outline width in pixels (0 for no outline)
+    /// @param color outline color
+    void setOutline(float width, const glm::vec4 &color);
+
+    /// @brief Get outline width
+    /// @return outline width in pixels
+    float outlineWidth() const;
+
+    /// @brief Get outline color
+    /// @return outline color
+    glm::vec4 outlineColor() const;
+
     /// @brief Set new text alignment
     /// @param alignment text alignment
     void setAlignment(TextAlignment alignment);
@@ -118,36 +163,38 @@ public:
     /// @return text alignment
     TextAlignment alignment() const;
 
-private:
-    /// @brief Struct containing data about a text line
-    struct Line {
-        Line(
-            size_t startIdx,
-            size_t endIdx,
-            float spacing,
-            size_t numWords
-        ) : startIdx{startIdx}, endIdx{endIdx}, spacing{spacing}, numWords{numWords} {}
+    /// @brief Get current layout, laying out text if needed
+    /// @return lines, glyph positions and bounding boxes, relative to top-left
+    std::shared_ptr<const ShapedRun> layout();
 
-        /// @brief Index on the text at which the line starts
-        size_t startIdx;
+    /// @brief Whether text has to be laid out again before being drawn
+    /// @return whether layout is dirty
+    bool isLayoutDirty() const;
 
-        /// @brief Index on the text at which the line ends
-        size_t endIdx;
+    /// @brief Lays out many texts at once, spreading the work over layout threads
+    /// @param texts texts to lay out (ones that aren't dirty are skipped)
+    /// @param count number of texts
+    /// @note Must be called from the thread that draws text. Results are the same as laying out each
+    ///       text on its own, and texts with identical inputs are only laid out once
+    static void layoutBatch(Text *const *texts, size_t count);
 
-        /// @brief How much space was left in the line
-        float spacing;
+private:
+    /// @brief Lays out current text, reusing a cached run with the same inputs if there is one
+    void shape();
 
-        /// @brief Number of words in the line
-        size_t numWords;
-    };
+    /// @brief Gets the inputs current layout depends on
+    /// @return shaped run cache key
+    ShapedRunKey layoutKey() const;
 
-    /// @brief Calculate lines data for current text
-    std::vector<Line> getLinesData();
+    /// @brief Lays out current text without looking at the cache
+    /// @param metrics metrics of current font
+    /// @return shaped run
+    ShapedRun computeLayout(const FontMetrics &metrics) const;
 
     /// @brief The text to be rendered
-    std::string _text;
+    TextBuffer _text;
 
-    /// @brief The font to use
+    /// @brief Handle to the font to use
     Font _font;
 
     /// @brief Font size, character height in pixels
@@ -165,6 +212,15 @@ private:
     /// @brief Text color
     glm::vec4 _color = glm::vec4{1.0f};
 
+    /// @brief Outline width in pixels
+    float _outlineWidth = 0.0f;
+
+    /// @brief Outline color
+    glm::vec4 _outlineColor = glm::vec4{0.0f, 0.0f, 0.0f, 1.0f};
+
     /// @brief Text alignment
     TextAlignment _alignment = TextAlignment::left;
+
+    /// @brief Current layout, shared with texts with the same inputs (null until next draw)
+    std::shared_ptr<const ShapedRun> _run;
 };
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <cstdint>
+
+/// @brief Editable text storage implemented as a persistent piece table
+/// @note Pieces are kept in a balanced tree, so inserting and erasing are O(log n) in the number of
+///       pieces. Copying a buffer is O(1) and yields an independent snapshot (useful for undo), since
+///       edits never modify nodes that are shared with other copies
+/// @note Not thread-safe for concurrent edits; read-only access from multiple threads is fine, the lazily
+///       built piece list is published atomically
+class TextBuffer {
+public:
+    /// @brief Forward iterator over the buffer characters, walking its pieces in order
+    /// @note Invalidated by any edit on the buffer it came from
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char *;
+        using reference = const char &;
+
+        /// @brief Default constructor
+        Iterator() = default;
+
+        reference operator*  () const;
+        Iterator& operator++ ();
+        Iterator  operator++ (int);
+
+        bool operator== (const Iterator &it) const;
+        bool operator!= (const Iterator &it) const;
+
+        /// @brief Get position of the current character in the whole buffer
+        /// @return character index
+        size_t position() const;
+
+    private:
+        friend class TextBuffer;
+
+        /// @brief Constructor
+        /// @param pieces pieces being iterated
+        /// @param pieceIdx index of current piece
+        Iterator(const std::vector<std::string_view> *pieces, size_t pieceIdx);
+
+        /// @brief Pieces being iterated
+        const std::vector<std::string_view> *_pieces = nullptr;
+
+        /// @brief Index of current piece
+        size_t _pieceIdx = 0;
+
+        /// @brief Offset inside current piece
+        size_t _offset = 0;
+
+        /// @brief Offset inside the whole buffer
+        size_t _position = 0;
+    };
+
+    /// @brief Default constructor
+    TextBuffer();
+
+    /// @brief Constructor with initial text
+    /// @param text initial text
+    TextBuffer(const std::string &text);
+
+    /// @brief Copy constructor, O(1), safe while other threads read the source
+    /// @param buffer buffer to copy
+    TextBuffer(const TextBuffer &buffer);
+
+    /// @brief Copy assignment, O(1), safe while other threads read the source
+    /// @param buffer buffer to copy
+    TextBuffer &operator= (const TextBuffer &buffer);
+
+    TextBuffer(TextBuffer &&) = default;
+    TextBuffer &operator= (TextBuffer &&) = default;
+
+    /// @brief Inserts text at a given position
+    /// @param pos character index to insert at (clamped to buffer size)
+    /// @param text text to insert
+    void insert(size_t pos, std::string_view text);
+
+    /// @brief Appends text at the end of the buffer
+    /// @param text text to append
+    void append(std::string_view text);
+
+    /// @brief Erases a range of characters
+    /// @param pos index of first character to erase
+    /// @param count number of characters to erase (clamped to buffer end)
+    void erase(size_t pos, size_t count = std::string::npos);
+
+    /// @brief Erases all characters
+    void clear();
+
+    /// @brief Returns a snapshot of the current contents, unaffected by later edits on this buffer
+    /// @return buffer snapshot
+    TextBuffer snapshot() const;
+
+    /// @brief Get number of characters
+    /// @return buffer size
+    size_t size() const;
+
+    /// @brief Whether buffer has no characters
+    /// @return whether buffer is empty
+    bool empty() const;
+
+    /// @brief Get character at a given position, in O(log n)
+    /// @param pos character index
+    /// @return character
+    char at(size_t pos) const;
+
+    /// @brief Finds last occurrence of a character
+    /// @param c character to search for
+    /// @return index of character, or std::string::npos if not found
+    size_t rfind(char c) const;
+
+    /// @brief Copies the buffer contents to a contiguous string
+    /// @return buffer contents
+    std::string toString() const;
+
+    /// @brief Copies a range of the buffer to a contiguous string
+    /// @param pos index of first character
+    /// @param count number of characters (clamped to buffer end)
+    /// @return range contents
+    std::string substr(size_t pos, size_t count = std::string::npos) const;
+
+    /// @brief Hashes buffer contents (64-bit FNV-1a), without copying them
+    /// @return hash, equal for buffers with equal contents however they were edited
+    uint64_t hash() const;
+
+    /// @brief Compares buffer contents piece by piece, without copying them
+    /// @param buffer buffer to compare with
+    /// @return whether both buffers hold the same characters, however they were edited
+    bool operator== (const TextBuffer &buffer) const;
+
+    bool operator!= (const TextBuffer &buffer) const;
+
+    /// @brief Gets the list of pieces that make up the buffer, in order
+    /// @return list of views over buffer storage, valid while no edits are made
+    const std::vector<std::string_view> &pieces() const;
+
+    /// @brief Iterator to first character
+    Iterator begin() const;
+
+    /// @brief Iterator past last character
+    Iterator end() const;
+
+    /// @brief Iterator to a given character, in O(log n)
+    /// @param pos character index (clamped to buffer size)
+    /// @return iterator to character
+    Iterator iteratorAt(size_t pos) const;
+
+    /// @brief Piece tree node (implementation detail)
+    struct Node;
+
+    /// @brief Shared text storage (implementation detail)
+    struct Storage;
+
+    /// @brief In-order list of pieces and their offsets (implementation detail)
+    struct PieceCache;
+
+private:
+    /// @brief Root of the piece tree
+    std::shared_ptr<const Node> _root;
+
+    /// @brief Append-only storage for all inserted text, shared between snapshots
+    std::shared_ptr<Storage> _storage;
+
+    /// @brief Gets piece cache, building it if an edit cleared it
+    /// @return cache, valid while no edits are made
+    const PieceCache &pieceCache() const;
+
+    /// @brief Cached in-order list of pieces, rebuilt on demand after edits
+    /// @note Only accessed through std::atomic_load and std::atomic_compare_exchange_strong by const
+    ///       methods, so concurrent readers never race on it
+    mutable std::shared_ptr<const PieceCache> _pieces;
+};
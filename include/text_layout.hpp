@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+
+#include "font_metrics.hpp"
+#include "shaped_run.hpp"
+#include "text_buffer.hpp"
+
+/// @brief Enum for different types of text alignment
+enum class TextAlignment {
+    /// @brief Aligned to left
+    left,
+
+    /// @brief Aligned to right
+    right,
+
+    /// @brief Aligned to center
+    center,
+
+    /// @brief Justified
+    justified
+};
+
+/// @brief Breaks text into lines and places its glyphs, using font metrics only
+/// @note Makes no OpenGL calls, so it can run on any thread (or with no window at all)
+class TextLayout {
+public:
+    /// @brief Struct containing data about a text line
+    struct Line {
+        Line(
+            size_t startIdx,
+            size_t endIdx,
+            float spacing,
+            size_t numWords
+        ) : startIdx{startIdx}, endIdx{endIdx}, spacing{spacing}, numWords{numWords} {}
+
+        /// @brief Index on the text at which the line starts
+        size_t startIdx;
+
+        /// @brief Index on the text at which the line ends
+        size_t endIdx;
+
+        /// @brief How much space was left in the line
+        float spacing;
+
+        /// @brief Number of words in the line
+        size_t numWords;
+    };
+
+    /// @brief Constructor
+    /// @param metrics font metrics, must outlive the layout
+    /// @param fontSize font size, character height in pixels
+    /// @param renderWidth how much the text extends horizontally in pixels
+    /// @param lineHeight line height in font size scale
+    /// @param alignment text alignment
+    TextLayout(
+        const FontMetrics &metrics,
+        float fontSize,
+        float renderWidth,
+        float lineHeight = 1.2f,
+        TextAlignment alignment = TextAlignment::left
+    );
+
+    /// @brief Calculate lines data for a text, relative to its top-left
+    /// @param text text to break into lines
+    /// @return lines, at least one
+    std::vector<Line> lines(const TextBuffer &text) const;
+
+    /// @brief Lays out a text, placing every visible glyph relative to its top-left
+    /// @param text text to lay out
+    /// @return lines, glyph positions and bounding boxes
+    ShapedRun layout(const TextBuffer &text) const;
+
+    /// @brief Get font size
+    /// @return font size in pixels
+    float fontSize() const;
+
+    /// @brief Get render width
+    /// @return render width in pixels
+    float renderWidth() const;
+
+    /// @brief Get line height
+    /// @return line height in font size scale
+    float lineHeight() const;
+
+    /// @brief Get text alignment
+    /// @return text alignment
+    TextAlignment alignment() const;
+
+private:
+    /// @brief Font metrics
+    const FontMetrics &_metrics;
+
+    /// @brief Font size, character height in pixels
+    float _fontSize;
+
+    /// @brief How much the text extends horizontally in pixels
+    float _renderWidth;
+
+    /// @brief Text line height in font size scale
+    float _lineHeight;
+
+    /// @brief Text alignment
+    TextAlignment _alignment;
+};
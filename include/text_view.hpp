@@ -0,0 +1,238 @@
+#pragma once
+
+#include <list>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "font.hpp"
+#include "text_buffer.hpp"
+
+/// @brief Scrollable view over a (possibly huge) text, which only lays out and draws visible lines
+/// @note Text is split in hard lines (by '\n'), which may wrap into several rows. Rows of lines never
+///       laid out are estimated as one, and corrected once they become visible
+class TextView {
+public:
+    /// @brief Default constructor
+    TextView() = default;
+
+    /// @brief Constructor
+    /// @param text text to display
+    /// @param font font to be used
+    TextView(const TextBuffer &text, const Font &font);
+
+    /// @brief Draws visible lines, clipped to the viewport
+    /// @param windowSize window size vector in pixels
+    void draw(const glm::vec2 &windowSize);
+
+    /// @brief Set new text, rebuilding the line index
+    /// @param text text buffer (only a snapshot is kept)
+    void setText(const TextBuffer &text);
+
+    /// @brief Get text
+    /// @return text buffer
+    const TextBuffer &text() const;
+
+    /// @brief Set new font
+    /// @param font font
+    void setFont(const Font &font);
+
+    /// @brief Get font
+    /// @return font handle, sharing glyphs with this one
+    Font font() const;
+
+    /// @brief Set new font size
+    /// @param fontSize font size
+    void setFontSize(float fontSize);
+
+    /// @brief Get font size
+    /// @return font size
+    float fontSize() const;
+
+    /// @brief Set new line height
+    /// @param lineHeight line height
+    void setLineHeight(float lineHeight);
+
+    /// @brief Get line height
+    /// @return line height
+    float lineHeight() const;
+
+    /// @brief Set new color
+    /// @param color color
+    void setColor(const glm::vec4 &color);
+
+    /// @brief Get color
+    /// @return color
+    glm::vec4 color() const;
+
+    /// @brief Set new viewport top left position vector
+    /// @param topLeft top left position vector in pixels
+    void setTopLeft(const glm::vec2 &topLeft);
+
+    /// @brief Get viewport top left position vector
+    /// @return top left position vector in pixels
+    glm::vec2 topLeft() const;
+
+    /// @brief Set new viewport size
+    /// @param size viewport size vector in pixels
+    void setSize(const glm::vec2 &size);
+
+    /// @brief Get viewport size
+    /// @return viewport size vector in pixels
+    glm::vec2 size() const;
+
+    /// @brief Set whether lines wrap at the viewport width
+    /// @param wrap whether lines wrap
+    void setWrap(bool wrap);
+
+    /// @brief Get whether lines wrap at the viewport width
+    /// @return whether lines wrap
+    bool wrap() const;
+
+    /// @brief Set new vertical scroll offset
+    /// @param scroll scroll offset in pixels (clamped to content)
+    void setScroll(float scroll);
+
+    /// @brief Scrolls by a given amount
+    /// @param delta scroll delta in pixels
+    void scrollBy(float delta);
+
+    /// @brief Get vertical scroll offset
+    /// @return scroll offset in pixels
+    float scroll() const;
+
+    /// @brief Get total content height (estimated for lines not laid out yet)
+    /// @return content height in pixels
+    float contentHeight() const;
+
+    /// @brief Get number of hard lines in text
+    /// @return number of lines
+    size_t numLines() const;
+
+    /// @brief Set maximum number of laid out glyphs kept in memory
+    /// @param maxCachedGlyphs maximum number of glyphs
+    /// @note Glyphs of visible lines are always kept, even if they exceed this amount
+    void setMaxCachedGlyphs(size_t maxCachedGlyphs);
+
+    /// @brief Get maximum number of laid out glyphs kept in memory
+    /// @return maximum number of glyphs
+    size_t maxCachedGlyphs() const;
+
+    /// @brief Get number of laid out glyphs currently in memory
+    /// @return number of glyphs
+    size_t cachedGlyphs() const;
+
+private:
+    /// @brief A glyph placed inside its line
+    struct Glyph {
+        /// @brief Glyph codepoint
+        uint32_t codepoint;
+
+        /// @brief Row inside line
+        uint32_t row;
+
+        /// @brief Horizontal offset from line start in pixels
+        float x;
+    };
+
+    /// @brief Laid out hard line
+    struct LineLayout {
+        /// @brief Visible glyphs (spaces are skipped)
+        std::vector<Glyph> glyphs;
+
+        /// @brief Number of rows after wrapping
+        uint32_t rows = 1;
+
+        /// @brief Last frame this line was drawn
+        size_t lastFrame = 0;
+
+        /// @brief Position in LRU list
+        std::list<size_t>::iterator lruIt;
+    };
+
+    /// @brief Builds line start offsets from the text
+    void rebuildIndex();
+
+    /// @brief Drops all laid out lines and row counts, for when layout inputs change
+    void resetLayout();
+
+    /// @brief Gets a line layout, laying it out if not cached
+    /// @param line hard line index
+    /// @return line layout
+    LineLayout &layoutLine(size_t line);
+
+    /// @brief Frees least recently used lines until glyph budget is met
+    void evictLines();
+
+    /// @brief Get height of a row in pixels
+    float rowHeight() const;
+
+    /// @brief Get total rows before a line
+    /// @param line hard line index
+    /// @return sum of rows of previous lines
+    size_t rowsBefore(size_t line) const;
+
+    /// @brief Finds line containing a given row
+    /// @param row row index
+    /// @return hard line index (numLines() if past the end)
+    size_t lineAtRow(size_t row) const;
+
+    /// @brief Updates row count of a line
+    /// @param line hard line index
+    /// @param rows new row count
+    void setLineRows(size_t line, uint32_t rows);
+
+    /// @brief The text to be rendered
+    TextBuffer _text;
+
+    /// @brief Handle to the font to use
+    Font _font;
+
+    /// @brief Font size, character height in pixels
+    float _fontSize = 20.0f;
+
+    /// @brief Text line height in font size scale
+    float _lineHeight = 1.2f;
+
+    /// @brief Text color
+    glm::vec4 _color = glm::vec4{1.0f};
+
+    /// @brief Viewport top-left position in pixels
+    glm::vec2 _topLeft = glm::vec2{0.0f};
+
+    /// @brief Viewport size in pixels
+    glm::vec2 _size = glm::vec2{0.0f};
+
+    /// @brief Whether lines wrap at viewport width
+    bool _wrap = true;
+
+    /// @brief Vertical scroll offset in pixels
+    float _scroll = 0.0f;
+
+    /// @brief Offset on the text at which each hard line starts
+    std::vector<size_t> _lineStarts;
+
+    /// @brief Row count of each hard line
+    std::vector<uint32_t> _lineRows;
+
+    /// @brief Fenwick tree over _lineRows, for O(log n) row <-> line queries
+    std::vector<size_t> _rowTree;
+
+    /// @brief Laid out lines, by hard line index
+    std::unordered_map<size_t, LineLayout> _layouts;
+
+    /// @brief Laid out lines, most recently used first
+    std::list<size_t> _lru;
+
+    /// @brief Number of glyphs in all laid out lines
+    size_t _cachedGlyphs = 0;
+
+    /// @brief Maximum number of laid out glyphs kept in memory
+    size_t _maxCachedGlyphs = 1 << 16;
+
+    /// @brief Frame counter, used to keep visible lines from being evicted
+    /// @note Starts at 1 so lines never drawn don't count as drawn on current frame
+    size_t _frame = 1;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+/// @brief Codepoint used in place of invalid UTF-8 sequences
+#define UTF8_REPLACEMENT_CHAR 0xFFFD
+
+/// @brief Decodes the next codepoint from a UTF-8 byte sequence, advancing past it
+/// @tparam It char iterator type
+/// @param it iterator to first byte of codepoint, advanced to the next one
+/// @param end iterator past last byte
+/// @return decoded codepoint, or UTF8_REPLACEMENT_CHAR if sequence is invalid
+template <typename It>
+uint32_t decodeUtf8(It &it, const It &end) {
+    const uint8_t lead = (uint8_t)*it;
+    ++it;
+
+    // ASCII fast path
+    if (lead < 0x80) return lead;
+
+    // Get sequence length and payload bits of lead byte
+    int length;
+    uint32_t codepoint;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        codepoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        codepoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        codepoint = lead & 0x07;
+    } else {
+        return UTF8_REPLACEMENT_CHAR;
+    }
+
+    // Read continuation bytes, without consuming an invalid one
+    for (int i = 1; i < length; ++i) {
+        if (it == end || ((uint8_t)*it & 0xC0) != 0x80) return UTF8_REPLACEMENT_CHAR;
+        codepoint = (codepoint << 6) | ((uint8_t)*it & 0x3F);
+        ++it;
+    }
+
+    // Reject overlong encodings, surrogates and out of range values
+    static const uint32_t minValue[] = {0, 0, 0x80, 0x800, 0x10000};
+    if (codepoint < minValue[length] || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        return UTF8_REPLACEMENT_CHAR;
+    }
+    return codepoint;
+}
+
+/// @brief Encodes a codepoint as UTF-8, appending it to a string
+/// @param codepoint codepoint to encode (invalid ones are encoded as UTF8_REPLACEMENT_CHAR)
+/// @param out string to append to
+inline void encodeUtf8(uint32_t codepoint, std::string &out) {
+    if (codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        codepoint = UTF8_REPLACEMENT_CHAR;
+    }
+
+    if (codepoint < 0x80) {
+        out += (char)codepoint;
+    } else if (codepoint < 0x800) {
+        out += (char)(0xC0 | (codepoint >> 6));
+        out += (char)(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        out += (char)(0xE0 | (codepoint >> 12));
+        out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        out += (char)(0x80 | (codepoint & 0x3F));
+    } else {
+        out += (char)(0xF0 | (codepoint >> 18));
+        out += (char)(0x80 | ((codepoint >> 12) & 0x3F));
+        out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        out += (char)(0x80 | (codepoint & 0x3F));
+    }
+}
@@ -0,0 +1,65 @@
+#version 330 core
+
+// Output color
+out vec4 fragColor;
+
+// Atlas page of glyphs in current batch
+uniform sampler2D atlas;
+
+in vec2 localPos;
+flat in vec2 halfSize;
+in vec2 uv;
+
+flat in float kind;
+flat in float outlineWidth;
+flat in vec4 instanceColor;
+flat in vec4 instanceData0;
+flat in vec4 instanceData1;
+
+// Primitive kinds, must match BatchModule
+const float KIND_ROUNDED_RECT = 0.0f;
+const float KIND_GLYPH = 1.0f;
+const float KIND_SDF_GLYPH = 2.0f;
+
+// Whether a point is cut off by an elliptical corner, tested only inside the corner box
+// (d is the distance to the corner edges, in pixels)
+bool outsideCorner(vec2 d, vec2 radius) {
+	if (radius.x <= 0.0f || radius.y <= 0.0f || d.x >= radius.x || d.y >= radius.y) return false;
+	vec2 n = (radius - d) / radius;
+	return dot(n, n) > 1.0f;
+}
+
+void main() {
+	if (kind < KIND_GLYPH - 0.5f) {
+		// Every corner whose box holds the fragment is tested, as one radius can reach past the
+		// midline when its neighbour is small. Negative y is the top
+		vec2 d = localPos + halfSize;
+		vec2 e = halfSize - localPos;
+		if (
+			outsideCorner(d, instanceData0.xy) ||
+			outsideCorner(vec2(e.x, d.y), instanceData0.zw) ||
+			outsideCorner(vec2(d.x, e.y), instanceData1.xy) ||
+			outsideCorner(e, instanceData1.zw)
+		) discard;
+		fragColor = instanceColor;
+	} else if (kind < KIND_SDF_GLYPH - 0.5f) {
+		float texAlpha = texture(atlas, uv).r;
+		if (texAlpha < 0.1f) discard;
+
+		fragColor = vec4(instanceColor.rgb, instanceColor.a * texAlpha);
+	} else {
+		// Distance to glyph edge, positive inside
+		float dist = texture(atlas, uv).r - 0.5f;
+
+		// Smooth edges over about one screen pixel, whatever the glyph scale
+		float smoothing = max(fwidth(dist) * 0.7f, 1e-4f);
+		float fill = smoothstep(-smoothing, smoothing, dist);
+		float outline = smoothstep(-smoothing, smoothing, dist + outlineWidth);
+
+		vec4 texColor = mix(instanceData1, instanceColor, fill);
+		float alpha = texColor.a * outline;
+		if (alpha <= 0.0f) discard;
+
+		fragColor = vec4(texColor.rgb, alpha);
+	}
+}
@@ -0,0 +1,51 @@
+#version 330 core
+
+// Unit quad vertex in [-1, 1], coming from vertex buffer
+layout (location = 0) in vec2 p;
+
+// Per instance: 2x2 linear part of the model matrix, as two columns
+layout (location = 1) in vec4 linear;
+
+// Per instance: translation (xy), primitive kind (z) and outline width (w)
+layout (location = 2) in vec4 originKind;
+
+// Per instance: color
+layout (location = 3) in vec4 color;
+
+// Per instance: corner radii of rounded rects (top left xy, top right zw) or atlas rectangle of glyphs
+layout (location = 4) in vec4 data0;
+
+// Per instance: corner radii of rounded rects (bottom left xy, bottom right zw) or outline color of glyphs
+layout (location = 5) in vec4 data1;
+
+// Projection matrix
+uniform mat4 projection;
+
+// Position in pixels relative to rounded rect center, and its half size
+out vec2 localPos;
+flat out vec2 halfSize;
+
+// Position on atlas texture, for glyphs
+out vec2 uv;
+
+// Instance data passed through
+flat out float kind;
+flat out float outlineWidth;
+flat out vec4 instanceColor;
+flat out vec4 instanceData0;
+flat out vec4 instanceData1;
+
+void main() {
+	mat2 model = mat2(linear.xy, linear.zw);
+	gl_Position = projection * vec4(originKind.xy + model * p, 0.0f, 1.0f);
+
+	halfSize = vec2(length(linear.xy), length(linear.zw));
+	localPos = p * halfSize;
+	uv = data0.xy + (p * 0.5f + 0.5f) * data0.zw;
+
+	kind = originKind.z;
+	outlineWidth = originKind.w;
+	instanceColor = color;
+	instanceData0 = data0;
+	instanceData1 = data1;
+}
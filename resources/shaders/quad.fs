@@ -6,25 +6,33 @@ out vec4 fragColor;
 // Quad data
 uniform vec4 color;
 
-uniform bool checkTL;
-uniform bool checkTR;
-uniform bool checkBL;
-uniform bool checkBR;
-
+#if defined(ROUNDED_CIRCULAR)
+// Same circular radius on every corner, in pixels
+uniform vec2 halfSize;
+uniform float radius;
+#elif defined(ROUNDED_ELLIPTICAL)
+// Elliptical radius of each corner, in [0, 1] quad scale (zero if corner is square)
 uniform vec2 borderTL;
 uniform vec2 borderTR;
 uniform vec2 borderBL;
 uniform vec2 borderBR;
 
+// Squared inverse radius of each corner
 uniform vec2 inv2TL;
 uniform vec2 inv2TR;
 uniform vec2 inv2BL;
 uniform vec2 inv2BR;
+#endif
 
 // Frag pos
 in vec2 fragPos;
 
 void main() {
+#if defined(ROUNDED_CIRCULAR)
+	// Rounded box distance, in pixels
+	vec2 q = abs(fragPos * halfSize) - halfSize + radius;
+	if (length(max(q, 0.0f)) > radius) discard;
+#elif defined(ROUNDED_ELLIPTICAL)
 	// Correct to [0, 1] range
 	vec2 uv = fragPos * 0.5f + 0.5f;
 	// Shader is rendered from bottom-left to top-right,
@@ -41,7 +49,7 @@ void main() {
 	float r;
 
 	// Bottom left
-	if (checkBL && uv.x < borderBL.x && uv.y < borderBL.y) {
+	if (uv.x < borderBL.x && uv.y < borderBL.y) {
 		isCorner = true;
 		invRadiusX2 = inv2BL.x;
 		invRadiusY2 = inv2BL.y;
@@ -54,7 +62,7 @@ void main() {
 	}
 
 	// Bottom right
-	if (checkBR && uv.x > (1.0f - borderBR.x) && uv.y < borderBR.y) {
+	if (uv.x > (1.0f - borderBR.x) && uv.y < borderBR.y) {
 		isCorner = true;
 		invRadiusX2 = inv2BR.x;
 		invRadiusY2 = inv2BR.y;
@@ -67,7 +75,7 @@ void main() {
 	}
 
 	// Top left
-	if (checkTL && uv.x < borderTL.x && uv.y > (1.0f - borderTL.y)) {
+	if (uv.x < borderTL.x && uv.y > (1.0f - borderTL.y)) {
 		isCorner = true;
 		invRadiusX2 = inv2TL.x;
 		invRadiusY2 = inv2TL.y;
@@ -80,7 +88,7 @@ void main() {
 	}
 
 	// Top right
-	if (checkTR && uv.x > (1.0f - borderTR.x) && uv.y > (1.0f - borderTR.y)) {
+	if (uv.x > (1.0f - borderTR.x) && uv.y > (1.0f - borderTR.y)) {
 		isCorner = true;
 		invRadiusX2 = inv2TR.x;
 		invRadiusY2 = inv2TR.y;
@@ -101,5 +109,7 @@ void main() {
 	// fragColor = vec4(alpha, 0.0f, 0.0f, 1.0f);
 
 	// fragColor = vec4(uv.x, uv.y, 0.0f, 1.0f);
+#endif
+
 	fragColor = color;
 }
@@ -7,6 +7,9 @@ layout (location = 0) in vec2 p;
 uniform mat4 model;
 uniform mat4 projection;
 
+// Glyph rectangle on atlas texture (offset, size)
+uniform vec4 uvRect;
+
 // Point to send for fragment shader
 out vec2 fragPos;
 
@@ -17,6 +20,6 @@ void main() {
 	// Update vertex position
 	gl_Position = vert;
 
-	// Send unchanged position to fragment shader
-	fragPos = p;
+	// Send position on atlas to fragment shader
+	fragPos = uvRect.xy + p * uvRect.zw;
 }
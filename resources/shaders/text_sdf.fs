@@ -0,0 +1,35 @@
+#version 330 core
+
+// Output color
+out vec4 fragColor;
+
+// Character signed distance field texture
+uniform sampler2D charTexture;
+
+// Character color
+uniform vec4 color;
+
+// Outline width in distance field units (0 for no outline)
+uniform float outlineWidth;
+
+// Outline color
+uniform vec4 outlineColor;
+
+// Frag pos
+in vec2 fragPos;
+
+void main() {
+	// Distance to glyph edge, positive inside
+	float dist = texture(charTexture, fragPos).r - 0.5f;
+
+	// Smooth edges over about one screen pixel, whatever the glyph scale
+	float smoothing = max(fwidth(dist) * 0.7f, 1e-4f);
+	float fill = smoothstep(-smoothing, smoothing, dist);
+	float outline = smoothstep(-smoothing, smoothing, dist + outlineWidth);
+
+	vec4 texColor = mix(outlineColor, color, fill);
+	float alpha = texColor.a * outline;
+	if (alpha <= 0.0f) discard;
+
+	fragColor = vec4(texColor.rgb, alpha);
+}
@@ -0,0 +1,165 @@
+#include <cstring>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#define ADVANCE_KERNELS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define ADVANCE_KERNELS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define ADVANCE_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+#include "advance_kernels.hpp"
+
+/// @brief Bytes checked at once for non-ASCII ones
+#if defined(ADVANCE_KERNELS_AVX2)
+static constexpr size_t CHUNK_SIZE = 32;
+#else
+static constexpr size_t CHUNK_SIZE = 16;
+#endif
+
+/// @brief Whether a whole chunk is ASCII
+/// @param bytes CHUNK_SIZE bytes
+/// @return whether no byte has its high bit set
+static inline bool isAsciiChunk(const unsigned char *bytes) {
+#if defined(ADVANCE_KERNELS_AVX2)
+    return _mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)bytes)) == 0;
+#elif defined(ADVANCE_KERNELS_SSE2)
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)bytes)) == 0;
+#elif defined(ADVANCE_KERNELS_NEON)
+    return vmaxvq_u8(vld1q_u8(bytes)) < 0x80;
+#else
+    uint64_t words[2];
+    std::memcpy(words, bytes, sizeof(words));
+    return ((words[0] | words[1]) & 0x8080808080808080ull) == 0;
+#endif
+}
+
+namespace AdvanceKernels {
+
+size_t sumAscii(const float *table, const unsigned char *bytes, size_t count, float &sum) {
+    size_t i = 0;
+
+#if defined(ADVANCE_KERNELS_AVX2)
+    __m256 acc = _mm256_setzero_ps();
+    for (; i + CHUNK_SIZE <= count && isAsciiChunk(bytes + i); i += CHUNK_SIZE) {
+        for (size_t j = 0; j < CHUNK_SIZE; j += 8) {
+            __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(bytes + i + j)));
+            acc = _mm256_add_ps(acc, _mm256_i32gather_ps(table, indices, 4));
+        }
+    }
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+    sum += _mm_cvtss_f32(half);
+#elif defined(ADVANCE_KERNELS_SSE2)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + CHUNK_SIZE <= count && isAsciiChunk(bytes + i); i += CHUNK_SIZE) {
+        const unsigned char *b = bytes + i;
+        for (size_t j = 0; j < CHUNK_SIZE; j += 4) {
+            acc = _mm_add_ps(acc, _mm_set_ps(table[b[j + 3]], table[b[j + 2]], table[b[j + 1]], table[b[j]]));
+        }
+    }
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    sum += _mm_cvtss_f32(acc);
+#elif defined(ADVANCE_KERNELS_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (; i + CHUNK_SIZE <= count && isAsciiChunk(bytes + i); i += CHUNK_SIZE) {
+        const unsigned char *b = bytes + i;
+        for (size_t j = 0; j < CHUNK_SIZE; j += 4) {
+            const float values[4] = {table[b[j]], table[b[j + 1]], table[b[j + 2]], table[b[j + 3]]};
+            acc = vaddq_f32(acc, vld1q_f32(values));
+        }
+    }
+    sum += vaddvq_f32(acc);
+#else
+    float acc[4] = {};
+    for (; i + CHUNK_SIZE <= count && isAsciiChunk(bytes + i); i += CHUNK_SIZE) {
+        const unsigned char *b = bytes + i;
+        for (size_t j = 0; j < CHUNK_SIZE; j += 4) {
+            acc[0] += table[b[j]];
+            acc[1] += table[b[j + 1]];
+            acc[2] += table[b[j + 2]];
+            acc[3] += table[b[j + 3]];
+        }
+    }
+    sum += (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+
+    // Tail, or chunk holding a non-ASCII byte
+    for (; i < count && bytes[i] < 0x80; ++i) {
+        sum += table[bytes[i]];
+    }
+    return i;
+}
+
+size_t prefixAscii(const float *table, const unsigned char *bytes, size_t count, float &sum, float scale, float *out) {
+    size_t i = 0;
+
+#if defined(ADVANCE_KERNELS_AVX2)
+    const __m256 scales = _mm256_set1_ps(scale);
+    const __m256i last = _mm256_set1_epi32(7);
+    __m256 carry = _mm256_set1_ps(sum);
+    for (; i + CHUNK_SIZE <= count && isAsciiChunk(bytes + i); i += CHUNK_SIZE) {
+        for (size_t j = 0; j < CHUNK_SIZE; j += 8) {
+            __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(bytes + i + j)));
+            __m256 v = _mm256_i32gather_ps(table, indices, 4);
+
+            // Prefix sum inside each 128-bit lane, then carry low lane total into high lane
+            v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 4)));
+            v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 8)));
+            __m128 lowTotal = _mm_shuffle_ps(_mm256_castps256_ps128(v), _mm256_castps256_ps128(v), 0xFF);
+            v = _mm256_add_ps(v, _mm256_insertf128_ps(_mm256_setzero_ps(), lowTotal, 1));
+
+            v = _mm256_add_ps(v, carry);
+            _mm256_storeu_ps(out + i + j, _mm256_mul_ps(v, scales));
+            carry = _mm256_permutevar8x32_ps(v, last);
+        }
+    }
+    sum = _mm256_cvtss_f32(carry);
+#elif defined(ADVANCE_KERNELS_SSE2)
+    const __m128 scales = _mm_set1_ps(scale);
+    __m128 carry = _mm_set1_ps(sum);
+    for (; i + CHUNK_SIZE <= count && isAsciiChunk(bytes + i); i += CHUNK_SIZE) {
+        const unsigned char *b = bytes + i;
+        for (size_t j = 0; j < CHUNK_SIZE; j += 4) {
+            __m128 v = _mm_set_ps(table[b[j + 3]], table[b[j + 2]], table[b[j + 1]], table[b[j]]);
+            v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)));
+            v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)));
+            v = _mm_add_ps(v, carry);
+            _mm_storeu_ps(out + i + j, _mm_mul_ps(v, scales));
+            carry = _mm_shuffle_ps(v, v, 0xFF);
+        }
+    }
+    sum = _mm_cvtss_f32(carry);
+#elif defined(ADVANCE_KERNELS_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    float32x4_t carry = vdupq_n_f32(sum);
+    for (; i + CHUNK_SIZE <= count && isAsciiChunk(bytes + i); i += CHUNK_SIZE) {
+        const unsigned char *b = bytes + i;
+        for (size_t j = 0; j < CHUNK_SIZE; j += 4) {
+            const float values[4] = {table[b[j]], table[b[j + 1]], table[b[j + 2]], table[b[j + 3]]};
+            float32x4_t v = vld1q_f32(values);
+            v = vaddq_f32(v, vextq_f32(zero, v, 3));
+            v = vaddq_f32(v, vextq_f32(zero, v, 2));
+            v = vaddq_f32(v, carry);
+            vst1q_f32(out + i + j, vmulq_n_f32(v, scale));
+            carry = vdupq_laneq_f32(v, 3);
+        }
+    }
+    sum = vgetq_lane_f32(carry, 0);
+#endif
+
+    // Tail, or chunk holding a non-ASCII byte (the whole span without SIMD)
+    for (; i < count && bytes[i] < 0x80; ++i) {
+        sum += table[bytes[i]];
+        out[i] = sum * scale;
+    }
+    return i;
+}
+
+} // AdvanceKernels
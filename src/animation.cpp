@@ -0,0 +1,225 @@
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "animation.hpp"
+
+/// @brief Shortest accepted duration in seconds, so progress is always defined
+static constexpr float MIN_DURATION = 1e-4f;
+
+/// @brief Animated values, one entry per value in every array
+/// @note Components of an animated property are stored next to each other, in order
+struct AnimatedValues {
+    /// @brief Quad each value is written to
+    std::vector<QuadHandle> targets;
+
+    /// @brief Property each value belongs to
+    std::vector<QuadProperty> properties;
+
+    /// @brief Index of the value within its property (e.g. 0 for red, 3 for alpha)
+    std::vector<uint8_t> components;
+
+    /// @brief Initial values
+    std::vector<float> from;
+
+    /// @brief Final values
+    std::vector<float> to;
+
+    /// @brief Start times in seconds
+    std::vector<float> start;
+
+    /// @brief Durations in seconds
+    std::vector<float> duration;
+
+    /// @brief Easing curves
+    std::vector<Easing> easing;
+
+    /// @brief Values of last update
+    std::vector<float> current;
+
+    /// @brief Get number of values
+    size_t size() const {
+        return targets.size();
+    }
+
+    /// @brief Removes values, keeping the order of the rest so components of a property stay together
+    /// @param shouldRemove predicate taking a value index
+    template <typename F>
+    void removeIf(F shouldRemove) {
+        size_t kept = 0;
+        for (size_t i = 0; i < size(); ++i) {
+            if (shouldRemove(i)) continue;
+            if (kept != i) {
+                targets[kept] = targets[i];
+                properties[kept] = properties[i];
+                components[kept] = components[i];
+                from[kept] = from[i];
+                to[kept] = to[i];
+                start[kept] = start[i];
+                duration[kept] = duration[i];
+                easing[kept] = easing[i];
+                current[kept] = current[i];
+            }
+            ++kept;
+        }
+        for (auto *v : {&from, &to, &start, &duration, &current}) v->resize(kept);
+        targets.resize(kept);
+        properties.resize(kept);
+        components.resize(kept);
+        easing.resize(kept);
+    }
+};
+
+/// @brief Every animated value
+static AnimatedValues values;
+
+/// @brief Gets the values of a quad property
+/// @param quad quad
+/// @param property property
+/// @param out where to write, 4 floats
+/// @return number of values
+static size_t readProperty(const Quad &quad, QuadProperty property, float *out) {
+    auto readDim2 = [&](const Dim2 &d) {
+        out[0] = (float)d.x().pixels();
+        out[1] = d.x().scale();
+        out[2] = (float)d.y().pixels();
+        out[3] = d.y().scale();
+        return 4;
+    };
+
+    switch (property) {
+        case QuadProperty::rotation:
+            out[0] = quad.rotation();
+            return 1;
+        case QuadProperty::color: {
+            const glm::vec4 color = quad.color();
+            for (int i = 0; i < 4; ++i) out[i] = color[i];
+            return 4;
+        }
+        case QuadProperty::position:
+            return readDim2(quad.position());
+        case QuadProperty::size:
+            return readDim2(quad.size());
+    }
+    return 0;
+}
+
+/// @brief Sets the values of a quad property
+/// @param quad quad
+/// @param property property
+/// @param in values, as given by readProperty
+static void writeProperty(Quad &quad, QuadProperty property, const float *in) {
+    auto toDim2 = [&]() {
+        return Dim2{(int)std::lround(in[0]), in[1], (int)std::lround(in[2]), in[3]};
+    };
+
+    switch (property) {
+        case QuadProperty::rotation:
+            quad.setRotation(in[0]);
+            break;
+        case QuadProperty::color:
+            quad.setColor(glm::vec4{in[0], in[1], in[2], in[3]});
+            break;
+        case QuadProperty::position:
+            quad.setPosition(toDim2());
+            break;
+        case QuadProperty::size:
+            quad.setSize(toDim2());
+            break;
+    }
+}
+
+/// @brief Starts animating a quad property from its current value
+/// @param target quad
+/// @param property property
+/// @param to final values, as given by readProperty
+/// @param start start time in seconds
+/// @param duration duration in seconds
+/// @param easing easing curve
+static void animate(QuadHandle target, QuadProperty property, const float *to, float start, float duration, Easing easing) {
+    Animations::stop(target, property);
+
+    const Quad *quad = QuadModule::get(target);
+    if (quad == nullptr) return;
+
+    float from[4];
+    const size_t count = readProperty(*quad, property, from);
+    for (size_t i = 0; i < count; ++i) {
+        values.targets.push_back(target);
+        values.properties.push_back(property);
+        values.components.push_back((uint8_t)i);
+        values.from.push_back(from[i]);
+        values.to.push_back(to[i]);
+        values.start.push_back(start);
+        values.duration.push_back(std::max(duration, MIN_DURATION));
+        values.easing.push_back(easing);
+        values.current.push_back(from[i]);
+    }
+}
+
+namespace Animations {
+
+void animateRotation(QuadHandle target, float to, float start, float duration, Easing easing) {
+    animate(target, QuadProperty::rotation, &to, start, duration, easing);
+}
+
+void animateColor(QuadHandle target, const glm::vec4 &to, float start, float duration, Easing easing) {
+    const float values[4] = {to.r, to.g, to.b, to.a};
+    animate(target, QuadProperty::color, values, start, duration, easing);
+}
+
+void animatePosition(QuadHandle target, const Dim2 &to, float start, float duration, Easing easing) {
+    const float values[4] = {(float)to.x().pixels(), to.x().scale(), (float)to.y().pixels(), to.y().scale()};
+    animate(target, QuadProperty::position, values, start, duration, easing);
+}
+
+void animateSize(QuadHandle target, const Dim2 &to, float start, float duration, Easing easing) {
+    const float values[4] = {(float)to.x().pixels(), to.x().scale(), (float)to.y().pixels(), to.y().scale()};
+    animate(target, QuadProperty::size, values, start, duration, easing);
+}
+
+void stop(QuadHandle target, QuadProperty property) {
+    values.removeIf([&](size_t i) {
+        return values.targets[i] == target && values.properties[i] == property;
+    });
+}
+
+void clear() {
+    values = AnimatedValues{};
+}
+
+bool update(float now) {
+    if (values.size() == 0) return false;
+
+    EasingKernels::evaluate(
+        values.from.data(), values.to.data(),
+        values.start.data(), values.duration.data(),
+        values.easing.data(), values.size(),
+        now, values.current.data()
+    );
+
+    // Components of a property are contiguous, so each property is written once with all of them
+    for (size_t i = 0; i < values.size();) {
+        const size_t first = i;
+        for (++i; i < values.size() && values.components[i] != 0; ++i) {}
+
+        if (!QuadModule::isValid(values.targets[first])) continue;
+        writeProperty(*QuadModule::get(values.targets[first]), values.properties[first], &values.current[first]);
+    }
+
+    // Remove finished animations and the ones of destroyed quads
+    values.removeIf([&](size_t i) {
+        return now >= values.start[i] + values.duration[i] || !QuadModule::isValid(values.targets[i]);
+    });
+    return values.size() > 0;
+}
+
+bool isAnimating() {
+    return values.size() > 0;
+}
+
+size_t count() {
+    return values.size();
+}
+
+} // Animations
@@ -3,8 +3,12 @@
 #include "glad/glad.h"
 
 #include "application.hpp"
+#include "batch.hpp"
 #include "font.hpp"
+#include "gl_extensions.hpp"
 #include "quad.hpp"
+#include "resources.hpp"
+#include "shader_cache.hpp"
 #include "text.hpp"
 #include "debug.hpp"
 
@@ -25,6 +29,11 @@ void defaultCharCallback(GLFWwindow* window, unsigned int codepoint) {
     app->charCallback(codepoint);
 }
 
+// Mouse scroll
+static void defaultScrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
+    Application *app = static_cast<Application*>(glfwGetWindowUserPointer(window));
+    app->scrollCallback(xoffset, yoffset);
+}
 
 static void glfwErrorCallback(int errorCode, const char* description) {
     std::cerr << "GLFW Error;\n";
@@ -38,7 +47,7 @@ Application::Application(
     int width,
     int height
 )
-    : title{title} {
+    : title{title}, _createdAt{std::chrono::steady_clock::now()} {
     glfwSetErrorCallback(glfwErrorCallback);
 
     // Init GLFW
@@ -61,6 +70,7 @@ Application::Application(
     glfwSetFramebufferSizeCallback(window, defaultframebufferSizeCallback);
     glfwSetKeyCallback(window, defaultKeyCallback);
     glfwSetCharCallback(window, defaultCharCallback);
+    glfwSetScrollCallback(window, defaultScrollCallback);
     glfwSetWindowUserPointer(window, this);
 
     // Load GLAD
@@ -70,28 +80,43 @@ Application::Application(
         glfwTerminate();
         exit(1);
     }
+    GLExtensions::load();
+    ShaderCache::setDirectory(rootPath + "/.shader-cache");
+
+    // Files on disk take precedence while developing, so shaders can be edited without rebuilding
+#if defined(DEBUG) || !defined(EMBED_RESOURCES)
+    Resources::setOverrideDirectory(rootPath + "/resources");
+#endif
 
     // Init modules
     // ------------
+    // Shader modules go first, so their compilation overlaps with font loading
     glm::vec2 windowSize{(float)width, (float)height};
-    if (!FontModule::init(rootPath)) {
-        std::cout << "Failed to initialize font module\n";
+    if (!QuadModule::init(windowSize)) {
+        std::cout << "Failed to initialize quad module\n";
         exit(1);
     }
 
-    if (!TextModule::init(rootPath, windowSize)) {
+    if (!TextModule::init()) {
         std::cout << "Failed to initialize text module\n";
         exit(1);
     }
 
-    if (!QuadModule::init(rootPath, windowSize)) {
-        std::cout << "Failed to initialize quad module\n";
+    if (!BatchModule::init()) {
+        std::cout << "Failed to initialize batch module\n";
         exit(1);
     }
+
+    if (!FontModule::init(rootPath)) {
+        std::cout << "Failed to initialize font module\n";
+        exit(1);
+    }
+    debugPrint("Shader programs: %zu from cache, %zu compiled\n", ShaderCache::hits(), ShaderCache::misses());
 }
 
 Application::~Application() {
     FontModule::terminate();
+    BatchModule::terminate();
     TextModule::terminate();
     QuadModule::terminate();
 
@@ -126,6 +151,18 @@ int Application::height() {
     return height;
 }
 
+float Application::timeToFirstFrame() const {
+    return _timeToFirstFrame;
+}
+
+void Application::swapBuffers() {
+    glfwSwapBuffers(window);
+    if (_timeToFirstFrame < 0.0f) {
+        _timeToFirstFrame = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - _createdAt).count();
+        debugPrint("Time to first frame: %.2fms\n", _timeToFirstFrame);
+    }
+}
+
 void Application::processInput() {
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
         glfwSetWindowShouldClose(window, true);
@@ -139,6 +176,7 @@ void Application::framebufferSizeCallback(int width, int height) {
     glm::vec2 windowSize{(float)width, (float)height};
     TextModule::onWindowResize(windowSize);
     QuadModule::onWindowResize(windowSize);
+    scene.onWindowResize(windowSize);
 }
 
 void Application::keyCallback(int key, int scancode, int action, int mods) {
@@ -150,4 +188,9 @@ void Application::keyCallback(int key, int scancode, int action, int mods) {
 
 void Application::charCallback(unsigned int codepoint) {
     (void)codepoint;
+}
+
+void Application::scrollCallback(double xoffset, double yoffset) {
+    (void)xoffset;
+    (void)yoffset;
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+#include "baked_font.hpp"
+
+/// @brief Magic bytes at the start of baked font files
+static const char BAKED_FONT_MAGIC[8] = {'O', 'G', 'L', 'U', 'I', 'F', 'N', 'T'};
+
+/// @brief Rounds a file offset up so records stay aligned when mapped
+/// @param offset offset in bytes
+/// @return aligned offset
+static uint64_t alignOffset(uint64_t offset) {
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+bool BakedFont::load(const std::string &path, const std::string &ttfPath, float fontHeight, GlyphRenderMode renderMode) {
+    if (!_file.open(path)) return false;
+    if (_file.size() < sizeof(Header)) {
+        close();
+        return false;
+    }
+
+    // Check file is complete and matches requested font, a missing TTF never validates a cache
+    const Header &h = header();
+    const std::optional<uint64_t> ttfHash = hashFile(ttfPath);
+    const size_t size = _file.size();
+    bool valid =
+        std::memcmp(h.magic, BAKED_FONT_MAGIC, sizeof(BAKED_FONT_MAGIC)) == 0 &&
+        h.version == BAKED_FONT_VERSION &&
+        h.fontHeight == fontHeight &&
+        h.renderMode == (uint32_t)renderMode &&
+        h.glyphsOffset + (uint64_t)h.numGlyphs * sizeof(Glyph) <= size &&
+        h.kerningOffset + (uint64_t)h.numKerningPairs * sizeof(KerningPair) <= size &&
+        h.pixelsOffset + (uint64_t)h.atlasWidth * h.atlasHeight <= size &&
+        ttfHash && h.ttfHash == *ttfHash;
+
+    if (!valid) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void BakedFont::close() {
+    _file.close();
+}
+
+const BakedFont::Header &BakedFont::header() const {
+    return *(const Header *)_file.data();
+}
+
+const BakedFont::Glyph *BakedFont::glyphs() const {
+    return (const Glyph *)(_file.data() + header().glyphsOffset);
+}
+
+const BakedFont::KerningPair *BakedFont::kerningPairs() const {
+    return (const KerningPair *)(_file.data() + header().kerningOffset);
+}
+
+const unsigned char *BakedFont::pixels() const {
+    return _file.data() + header().pixelsOffset;
+}
+
+bool BakedFont::write(
+    const std::string &path,
+    Header header,
+    const std::vector<Glyph> &glyphs,
+    const std::vector<KerningPair> &kerningPairs,
+    const std::vector<unsigned char> &pixels
+) {
+    std::memcpy(header.magic, BAKED_FONT_MAGIC, sizeof(BAKED_FONT_MAGIC));
+    header.version = BAKED_FONT_VERSION;
+    header.numGlyphs = glyphs.size();
+    header.numKerningPairs = kerningPairs.size();
+    header.reserved = 0;
+    header.glyphsOffset = alignOffset(sizeof(Header));
+    header.kerningOffset = alignOffset(header.glyphsOffset + glyphs.size() * sizeof(Glyph));
+    header.pixelsOffset = alignOffset(header.kerningOffset + kerningPairs.size() * sizeof(KerningPair));
+
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file) return false;
+
+    // Writes a block at its offset, zero-filling alignment gaps
+    auto writeAt = [&file](uint64_t offset, const void *data, size_t size) {
+        static const char zeros[8] = {};
+        file.write(zeros, offset - (uint64_t)file.tellp());
+        file.write((const char *)data, size);
+    };
+    writeAt(0, &header, sizeof(Header));
+    writeAt(header.glyphsOffset, glyphs.data(), glyphs.size() * sizeof(Glyph));
+    writeAt(header.kerningOffset, kerningPairs.data(), kerningPairs.size() * sizeof(KerningPair));
+    writeAt(header.pixelsOffset, pixels.data(), pixels.size());
+
+    return (bool)file;
+}
+
+std::optional<uint64_t> BakedFont::hashFile(const std::string &path) {
+    MappedFile file;
+    if (!file.open(path)) return std::nullopt;
+
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < file.size(); ++i) {
+        hash ^= file.data()[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string BakedFont::pathFor(const std::string &ttfPath, float fontHeight, GlyphRenderMode renderMode) {
+    // Replace extension (if any) with size and mode
+    size_t slash = ttfPath.find_last_of("/\\");
+    size_t dot = ttfPath.find_last_of('.');
+    bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+
+    std::stringstream sstr;
+    sstr << (hasExtension ? ttfPath.substr(0, dot) : ttfPath) << "-" << fontHeight;
+    if (renderMode == GlyphRenderMode::sdf) sstr << "-sdf";
+    sstr << ".fontcache";
+    return sstr.str();
+}
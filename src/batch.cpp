@@ -0,0 +1,241 @@
+#include <vector>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "glad/glad.h"
+
+#include "batch.hpp"
+#include "debug.hpp"
+#include "shader.hpp"
+
+/// @brief Primitive kinds, must match batch.fs
+enum PrimitiveKind {
+    KIND_ROUNDED_RECT = 0,
+    KIND_GLYPH = 1,
+    KIND_SDF_GLYPH = 2,
+};
+
+/// @brief Per instance vertex data
+struct Instance {
+    /// @brief 2x2 linear part of the model matrix, as two columns
+    glm::vec4 linear;
+
+    /// @brief Translation (xy), primitive kind (z) and outline width (w)
+    glm::vec4 originKind;
+
+    /// @brief Color
+    glm::vec4 color;
+
+    /// @brief Top corner radii of rounded rects, atlas rectangle of glyphs
+    glm::vec4 data0;
+
+    /// @brief Bottom corner radii of rounded rects, outline color of glyphs
+    glm::vec4 data1;
+};
+static_assert(sizeof(Instance) == 20 * sizeof(float), "Instance must be tightly packed");
+
+/// @brief Shader drawing every primitive kind
+static Shader batchShader;
+
+/// @brief OpenGL objects for batched rendering
+static unsigned int batchVAO, batchVBO, batchEBO, instanceVBO;
+
+/// @brief Size of instance buffer in bytes
+static size_t instanceCapacity = 0;
+
+/// @brief Instances recorded since last flush
+static std::vector<Instance> pending;
+
+/// @brief Atlas page sampled by pending glyphs, 0 if none
+static unsigned int pendingTexture = 0;
+
+/// @brief Whether a frame is being recorded
+static bool recording = false;
+
+/// @brief Stats of the frame being recorded and of the last one
+static size_t frameDrawCalls = 0, frameInstances = 0;
+static size_t lastDrawCalls = 0, lastInstances = 0;
+
+/// @brief Whether batch resources are already initialized
+static bool initialized = false;
+
+namespace BatchModule {
+
+bool init() {
+    if (initialized) return true;
+    initialized = true;
+
+    // Initialize shader, projection is set by begin
+    // ---------------------------------------------
+    batchShader = Shader{
+        "shaders/batch.vs",
+        "shaders/batch.fs"
+    };
+
+    // Construct VAO for batched rendering
+    // -----------------------------------
+
+    // Default vertices for quad
+    const float __vertices[] = {
+        // positions
+        -1.0f, -1.0f, // top left
+        -1.0f,  1.0f, // bottom left
+        1.0f,  1.0f, // bottom right
+        1.0f, -1.0f, // top right
+    };
+
+    // Default indices for quad
+    const unsigned int __indices[] = {
+        0, 1, 2, // first triangle
+        0, 2, 3  // second triangle
+    };
+
+    // Create vertex objects
+    glGenVertexArrays(1, &batchVAO); glCheckError();
+
+    glGenBuffers(1, &batchVBO); glCheckError();
+    glGenBuffers(1, &batchEBO); glCheckError();
+    glGenBuffers(1, &instanceVBO); glCheckError();
+
+    // Bind the array (VAO) first
+    glBindVertexArray(batchVAO); glCheckError();
+
+    // Then bind and set the buffer (VBO)
+    glBindBuffer(GL_ARRAY_BUFFER, batchVBO); glCheckError();
+    glBufferData(GL_ARRAY_BUFFER, sizeof(__vertices), __vertices, GL_STATIC_DRAW); glCheckError();
+
+    // Then bind and set the elements buffer
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batchEBO); glCheckError();
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(__indices), __indices, GL_STATIC_DRAW); glCheckError();
+
+    // Position attribute
+    glEnableVertexAttribArray(0); glCheckError();
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void *)0); glCheckError();
+
+    // Instance attributes, advancing once per instance
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO); glCheckError();
+    for (unsigned int i = 0; i < 5; ++i) {
+        glEnableVertexAttribArray(1 + i); glCheckError();
+        glVertexAttribPointer(1 + i, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void *)(i * sizeof(glm::vec4))); glCheckError();
+        glVertexAttribDivisor(1 + i, 1); glCheckError();
+    }
+
+    // Unbind buffers
+    glBindVertexArray(0); glCheckError();
+    glBindBuffer(GL_ARRAY_BUFFER, 0); glCheckError();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); glCheckError();
+
+    // Adding an empty string at the end to suppress compiler warning
+    debugPrint("Batch module successfully loaded\n%s", "");
+    return true;
+}
+
+void terminate() {
+    if (!initialized) return;
+    initialized = false;
+
+    batchShader.destroy();
+    glDeleteBuffers(1, &batchVBO); glCheckError();
+    glDeleteBuffers(1, &batchEBO); glCheckError();
+    glDeleteBuffers(1, &instanceVBO); glCheckError();
+    glDeleteVertexArrays(1, &batchVAO); glCheckError();
+    instanceCapacity = 0;
+    pending.clear();
+}
+
+void begin(const glm::vec2 &windowSize) {
+    recording = true;
+    frameDrawCalls = 0;
+    frameInstances = 0;
+
+    auto projection = glm::ortho(0.0f, windowSize.x, windowSize.y, 0.0f, 0.0f, 1.0f);
+    batchShader.setMat4("projection", projection);
+    batchShader.setInt("atlas", 0);
+}
+
+void end() {
+    flush();
+    recording = false;
+    lastDrawCalls = frameDrawCalls;
+    lastInstances = frameInstances;
+}
+
+bool isRecording() {
+    return recording;
+}
+
+void flush() {
+    if (!recording || pending.empty()) return;
+
+    // Buffer is orphaned before every upload, so the driver never waits on the previous draw
+    const size_t bytes = pending.size() * sizeof(Instance);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO); glCheckError();
+    if (bytes > instanceCapacity) instanceCapacity = std::max(bytes, instanceCapacity * 2);
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity, nullptr, GL_STREAM_DRAW); glCheckError();
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, pending.data()); glCheckError();
+    glBindBuffer(GL_ARRAY_BUFFER, 0); glCheckError();
+
+    batchShader.use();
+    glActiveTexture(GL_TEXTURE0); glCheckError();
+    glBindTexture(GL_TEXTURE_2D, pendingTexture); glCheckError();
+    glBindVertexArray(batchVAO); glCheckError();
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, (GLsizei)pending.size()); glCheckError();
+    glBindVertexArray(0); glCheckError();
+
+    ++frameDrawCalls;
+    frameInstances += pending.size();
+    pending.clear();
+    pendingTexture = 0;
+}
+
+void submitQuad(
+    const glm::mat4 &model,
+    const glm::vec4 &color,
+    const glm::vec4 &radiiTop,
+    const glm::vec4 &radiiBottom
+) {
+    pending.push_back(Instance{
+        glm::vec4{model[0][0], model[0][1], model[1][0], model[1][1]},
+        glm::vec4{model[3][0], model[3][1], (float)KIND_ROUNDED_RECT, 0.0f},
+        color,
+        radiiTop,
+        radiiBottom
+    });
+}
+
+void submitGlyph(
+    unsigned int texture,
+    const glm::vec2 &topLeft,
+    const glm::vec2 &size,
+    const glm::vec4 &uvRect,
+    const glm::vec4 &color,
+    GlyphRenderMode renderMode,
+    float outlineWidth,
+    const glm::vec4 &outlineColor
+) {
+    // A batch samples a single atlas page, quads don't sample any
+    if (pendingTexture != 0 && pendingTexture != texture) flush();
+    pendingTexture = texture;
+
+    const glm::vec2 halfSize = size * 0.5f;
+    const float kind = renderMode == GlyphRenderMode::sdf ? KIND_SDF_GLYPH : KIND_GLYPH;
+    pending.push_back(Instance{
+        glm::vec4{halfSize.x, 0.0f, 0.0f, halfSize.y},
+        glm::vec4{topLeft + halfSize, kind, outlineWidth},
+        color,
+        uvRect,
+        outlineColor
+    });
+}
+
+size_t drawCalls() {
+    return lastDrawCalls;
+}
+
+size_t instances() {
+    return lastInstances;
+}
+
+} // BatchModule
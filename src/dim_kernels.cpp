@@ -0,0 +1,60 @@
+#if defined(__AVX2__)
+#define DIM_KERNELS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define DIM_KERNELS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define DIM_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+#include "dim_kernels.hpp"
+
+namespace DimKernels {
+
+void resolve(const float *pixels, const float *scales, size_t count, float axisX, float axisY, float *out) {
+    const size_t n = count * 2;
+    size_t i = 0;
+
+#if defined(DIM_KERNELS_AVX2)
+    const __m256 axis = _mm256_setr_ps(axisX, axisY, axisX, axisY, axisX, axisY, axisX, axisY);
+    for (; i + 8 <= n; i += 8) {
+        __m256 scaled = _mm256_mul_ps(_mm256_loadu_ps(scales + i), axis);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(pixels + i), scaled));
+    }
+#elif defined(DIM_KERNELS_SSE2)
+    const __m128 axis = _mm_setr_ps(axisX, axisY, axisX, axisY);
+    for (; i + 4 <= n; i += 4) {
+        __m128 scaled = _mm_mul_ps(_mm_loadu_ps(scales + i), axis);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(pixels + i), scaled));
+    }
+#elif defined(DIM_KERNELS_NEON)
+    const float axisValues[4] = {axisX, axisY, axisX, axisY};
+    const float32x4_t axis = vld1q_f32(axisValues);
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t scaled = vmulq_f32(vld1q_f32(scales + i), axis);
+        vst1q_f32(out + i, vaddq_f32(vld1q_f32(pixels + i), scaled));
+    }
+#endif
+
+    // Tail, or the whole span without SIMD
+    for (; i < n; i += 2) {
+        out[i] = pixels[i] + scales[i] * axisX;
+        out[i + 1] = pixels[i + 1] + scales[i + 1] * axisY;
+    }
+}
+
+const char *name() {
+#if defined(DIM_KERNELS_AVX2)
+    return "avx2";
+#elif defined(DIM_KERNELS_SSE2)
+    return "sse2";
+#elif defined(DIM_KERNELS_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // DimKernels
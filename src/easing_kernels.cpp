@@ -0,0 +1,147 @@
+#if defined(__AVX2__)
+#define EASING_KERNELS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define EASING_KERNELS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define EASING_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+
+#include "easing_kernels.hpp"
+
+static_assert(sizeof(Easing) == sizeof(uint32_t), "Easing codes are loaded as 32-bit lanes");
+
+/// @brief Eases a single progress value
+/// @param easing easing curve
+/// @param t progress in [0, 1]
+/// @return interpolation factor
+static inline float ease(Easing easing, float t) {
+    switch (easing) {
+        case Easing::linear:
+            return t;
+        case Easing::easeIn:
+            return t * t;
+        case Easing::easeOut:
+            return t * (2.0f - t);
+        case Easing::easeInOut:
+            return t < 0.5f ? 2.0f * t * t : (4.0f - 2.0f * t) * t - 1.0f;
+    }
+    return t;
+}
+
+namespace EasingKernels {
+
+void evaluate(
+    const float *from, const float *to,
+    const float *start, const float *duration,
+    const Easing *easing, size_t count,
+    float now, float *out
+) {
+    const uint32_t *codes = (const uint32_t *)easing;
+    size_t i = 0;
+
+#if defined(EASING_KERNELS_AVX2)
+    const __m256 vNow = _mm256_set1_ps(now);
+    const __m256 zero = _mm256_setzero_ps(), half = _mm256_set1_ps(0.5f), one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f), four = _mm256_set1_ps(4.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m256 t = _mm256_div_ps(_mm256_sub_ps(vNow, _mm256_loadu_ps(start + i)), _mm256_loadu_ps(duration + i));
+        t = _mm256_min_ps(_mm256_max_ps(t, zero), one);
+
+        const __m256 easeIn = _mm256_mul_ps(t, t);
+        const __m256 easeOut = _mm256_mul_ps(t, _mm256_sub_ps(two, t));
+        const __m256 easeInOut = _mm256_blendv_ps(
+            _mm256_add_ps(easeIn, easeIn),
+            _mm256_sub_ps(_mm256_mul_ps(_mm256_sub_ps(four, _mm256_add_ps(t, t)), t), one),
+            _mm256_cmp_ps(t, half, _CMP_GE_OQ)
+        );
+
+        const __m256i code = _mm256_loadu_si256((const __m256i *)(codes + i));
+        __m256 e = t;
+        e = _mm256_blendv_ps(e, easeIn, _mm256_castsi256_ps(_mm256_cmpeq_epi32(code, _mm256_set1_epi32((int)Easing::easeIn))));
+        e = _mm256_blendv_ps(e, easeOut, _mm256_castsi256_ps(_mm256_cmpeq_epi32(code, _mm256_set1_epi32((int)Easing::easeOut))));
+        e = _mm256_blendv_ps(e, easeInOut, _mm256_castsi256_ps(_mm256_cmpeq_epi32(code, _mm256_set1_epi32((int)Easing::easeInOut))));
+
+        const __m256 a = _mm256_loadu_ps(from + i);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(to + i), a), e)));
+    }
+#elif defined(EASING_KERNELS_SSE2)
+    // Lanes are selected with and/andnot/or, SSE2 has no blend
+    auto select = [](__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+    };
+    const __m128 vNow = _mm_set1_ps(now);
+    const __m128 zero = _mm_setzero_ps(), half = _mm_set1_ps(0.5f), one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f), four = _mm_set1_ps(4.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 t = _mm_div_ps(_mm_sub_ps(vNow, _mm_loadu_ps(start + i)), _mm_loadu_ps(duration + i));
+        t = _mm_min_ps(_mm_max_ps(t, zero), one);
+
+        const __m128 easeIn = _mm_mul_ps(t, t);
+        const __m128 easeOut = _mm_mul_ps(t, _mm_sub_ps(two, t));
+        const __m128 easeInOut = select(
+            _mm_cmpge_ps(t, half),
+            _mm_add_ps(easeIn, easeIn),
+            _mm_sub_ps(_mm_mul_ps(_mm_sub_ps(four, _mm_add_ps(t, t)), t), one)
+        );
+
+        const __m128i code = _mm_loadu_si128((const __m128i *)(codes + i));
+        __m128 e = t;
+        e = select(_mm_castsi128_ps(_mm_cmpeq_epi32(code, _mm_set1_epi32((int)Easing::easeIn))), e, easeIn);
+        e = select(_mm_castsi128_ps(_mm_cmpeq_epi32(code, _mm_set1_epi32((int)Easing::easeOut))), e, easeOut);
+        e = select(_mm_castsi128_ps(_mm_cmpeq_epi32(code, _mm_set1_epi32((int)Easing::easeInOut))), e, easeInOut);
+
+        const __m128 a = _mm_loadu_ps(from + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(to + i), a), e)));
+    }
+#elif defined(EASING_KERNELS_NEON)
+    const float32x4_t vNow = vdupq_n_f32(now);
+    const float32x4_t zero = vdupq_n_f32(0.0f), half = vdupq_n_f32(0.5f), one = vdupq_n_f32(1.0f);
+    const float32x4_t two = vdupq_n_f32(2.0f), four = vdupq_n_f32(4.0f);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t t = vdivq_f32(vsubq_f32(vNow, vld1q_f32(start + i)), vld1q_f32(duration + i));
+        t = vminq_f32(vmaxq_f32(t, zero), one);
+
+        const float32x4_t easeIn = vmulq_f32(t, t);
+        const float32x4_t easeOut = vmulq_f32(t, vsubq_f32(two, t));
+        const float32x4_t easeInOut = vbslq_f32(
+            vcgeq_f32(t, half),
+            vsubq_f32(vmulq_f32(vsubq_f32(four, vaddq_f32(t, t)), t), one),
+            vaddq_f32(easeIn, easeIn)
+        );
+
+        const uint32x4_t code = vld1q_u32(codes + i);
+        float32x4_t e = t;
+        e = vbslq_f32(vceqq_u32(code, vdupq_n_u32((uint32_t)Easing::easeIn)), easeIn, e);
+        e = vbslq_f32(vceqq_u32(code, vdupq_n_u32((uint32_t)Easing::easeOut)), easeOut, e);
+        e = vbslq_f32(vceqq_u32(code, vdupq_n_u32((uint32_t)Easing::easeInOut)), easeInOut, e);
+
+        const float32x4_t a = vld1q_f32(from + i);
+        vst1q_f32(out + i, vaddq_f32(a, vmulq_f32(vsubq_f32(vld1q_f32(to + i), a), e)));
+    }
+#endif
+
+    // Tail, or the whole span without SIMD
+    for (; i < count; ++i) {
+        const float t = std::clamp((now - start[i]) / duration[i], 0.0f, 1.0f);
+        out[i] = from[i] + (to[i] - from[i]) * ease(easing[i], t);
+    }
+}
+
+const char *name() {
+#if defined(EASING_KERNELS_AVX2)
+    return "avx2";
+#elif defined(EASING_KERNELS_SSE2)
+    return "sse2";
+#elif defined(EASING_KERNELS_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // EasingKernels
@@ -2,17 +2,108 @@
 #include <sstream>
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
+#include <chrono>
 
 #include "glad/glad.h"
 
 #include "debug.hpp"
+#include "baked_font.hpp"
+#include "batch.hpp"
 #include "font.hpp"
+#include "glyph_atlas.hpp"
+#include "glyph_rasterizer.hpp"
+#include "mapped_file.hpp"
+#include "resources.hpp"
+
+/// @brief Font info and glyphs, shared by every handle to the same font
+struct Font::Glyphs {
+    /// @brief Frees font resources if they weren't freed yet
+    ~Glyphs();
+
+    /// @brief Frees FreeType face and glyph textures
+    void release();
+
+    /// @brief Path to font file, relative to project root
+    std::string ttfPath;
+
+    /// @brief Font height in pixels
+    float fontHeight;
+
+    /// @brief How glyphs are rasterized
+    GlyphRenderMode renderMode;
+
+    /// @brief Glyph metrics, shared with layouts that may outlive the font
+    std::shared_ptr<const FontMetrics> metrics;
+
+    /// @brief Loaded characters, by codepoint
+    std::unordered_map<uint32_t, Character> characters;
+
+    /// @brief Fast path for ASCII characters, pointing into characters map
+    Character *ascii[128] = {};
+
+    /// @brief Atlas holding glyph bitmaps, sized on first insert (see insertGlyph)
+    GlyphAtlas atlas;
+
+    /// @brief Whether atlas was sized, which baked fonts may never need
+    bool hasAtlas = false;
+
+    /// @brief Identifier used by background rasterizer requests
+    uint64_t id;
+
+    /// @brief Full path to font file
+    std::string path;
+
+    /// @brief Codepoints requested to the background rasterizer and not uploaded yet
+    std::unordered_set<uint32_t> pending;
+
+    /// @brief FreeType face, only opened when a glyph has to be rasterized
+    FT_Face face = nullptr;
+
+    /// @brief Mapped font file the faces read from
+    std::shared_ptr<const MappedFile> file;
+
+    /// @brief Texture holding baked glyphs, 0 if font isn't baked
+    unsigned int bakedTexture = 0;
+};
+
+/// @brief Atlas slot marking baked glyphs, which live on their own texture
+static constexpr uint32_t BAKED_SLOT = GlyphAtlas::NO_SLOT - 1;
+
+/// @brief Atlas slot marking glyphs FreeType failed to render, which are never retried
+static constexpr uint32_t FAILED_SLOT = GlyphAtlas::NO_SLOT - 2;
 
 /// @brief Global pointer to FreeType library object
 static FT_Library ft;
 
-/// @brief Map of currenty loaded fonts
-static std::unordered_map<std::string, Font> loadedFonts;
+/// @brief Key of a font on loaded fonts map
+struct FontKey {
+    /// @brief Path to font file
+    std::string ttfPath;
+
+    /// @brief Font height in pixels
+    float fontHeight;
+
+    /// @brief How glyphs are rasterized
+    GlyphRenderMode renderMode;
+
+    bool operator== (const FontKey &other) const {
+        return ttfPath == other.ttfPath && fontHeight == other.fontHeight && renderMode == other.renderMode;
+    }
+};
+
+/// @brief Hash function for font keys
+struct FontKeyHash {
+    size_t operator() (const FontKey &key) const {
+        size_t hash = std::hash<std::string>{}(key.ttfPath);
+        hash ^= std::hash<float>{}(key.fontHeight) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= (size_t)key.renderMode + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+/// @brief Map of currenty loaded fonts, which are freed when their last handle goes away
+static std::unordered_map<FontKey, std::weak_ptr<Font::Glyphs>, FontKeyHash> loadedFonts;
 
 /// @brief Whether font resources are already initialized
 static bool initialized = false;
@@ -20,20 +111,64 @@ static bool initialized = false;
 /// @brief Project root path
 static std::string _rootPath = "";
 
-const char *FT_Error_String(FT_Error error) {
-    #undef FTERRORS_H_
-    #define FT_ERROR_START_LIST     switch(error) {
-    #define FT_ERRORDEF(e, v, s)    case e:\
-                                        return s;
-    #define FT_ERROR_END_LIST       default:\
-                                        return "Unknown error"; \
-                                    }
-    #include "freetype/fterrors.h"
+/// @brief Glyph atlas budget for new fonts
+static size_t _glyphAtlasBudget = DEFAULT_GLYPH_ATLAS_BUDGET;
+
+/// @brief Number of background rasterizer threads
+static unsigned int _rasterizerThreads = 0;
+
+/// @brief Background glyph rasterizer, null if disabled
+static std::unique_ptr<GlyphRasterizer> rasterizer;
+
+/// @brief Glyphs of each loaded font, by identifier, so rasterized glyphs can find their font
+static std::unordered_map<uint64_t, std::weak_ptr<Font::Glyphs>> glyphStores;
+
+/// @brief Identifier for next loaded font
+static uint64_t nextFontId = 1;
+
+/// @brief Font files mapped in memory, by full path
+static std::unordered_map<std::string, std::weak_ptr<const MappedFile>> mappedFiles;
+
+/// @brief Gets atlas cell size fitting any glyph of a font
+/// @param metrics font metrics, whose face gives the glyph bounds
+/// @param fontHeight font height in pixels
+/// @param renderMode how glyphs are rasterized
+/// @return cell size in pixels
+static glm::ivec2 atlasCellSize(const FontMetrics &metrics, float fontHeight, GlyphRenderMode renderMode) {
+    glm::ivec2 cellSize = glm::clamp(metrics.glyphBounds(), glm::ivec2{1, 1}, glm::ivec2{(int)(2.0f * fontHeight)});
+
+    // Distance fields extend past the outline on every side
+    if (renderMode == GlyphRenderMode::sdf) {
+        cellSize += glm::ivec2{2 * SDF_SPREAD};
+    }
+    return cellSize;
 }
 
-void FT_CheckError(const std::string &prefix, FT_Error code) {
-    auto str = FT_Error_String(code);
-    debugPrint("[FREETYPE] %s: %s\n", prefix.c_str(), str);
+/// @brief Stores a glyph bitmap on a font atlas, drawing batched glyphs first if a cell is to be overwritten
+/// @note Atlas is sized here on first use, whichever path rasterized the glyph and whether font was baked or not
+/// @return slot where glyph was stored
+static uint32_t insertGlyph(Font::Glyphs &glyphs, uint32_t codepoint, const unsigned char *bitmap, int width, int rows, int pitch) {
+    if (!glyphs.hasAtlas) {
+        glyphs.atlas = GlyphAtlas{atlasCellSize(*glyphs.metrics, glyphs.fontHeight, glyphs.renderMode), _glyphAtlasBudget};
+        glyphs.hasAtlas = true;
+    }
+
+    // Glyphs batched this frame may still sample the evicted cell
+    if (glyphs.atlas.full()) BatchModule::flush();
+    return glyphs.atlas.insert(codepoint, bitmap, width, rows, pitch);
+}
+
+/// @brief Starts or stops background rasterizer according to thread count
+static void restartRasterizer() {
+    // Requests in flight are lost, so they must be sent again
+    rasterizer.reset();
+    for (auto &[id, store] : glyphStores) {
+        if (auto glyphs = store.lock()) glyphs->pending.clear();
+    }
+
+    if (_rasterizerThreads > 0) {
+        rasterizer = std::make_unique<GlyphRasterizer>(_rasterizerThreads);
+    }
 }
 
 namespace FontModule {
@@ -49,6 +184,9 @@ bool init(const std::string &rootPath) {
         FT_CheckError("FT_Init_FreeType", error);
         return false;
     }
+    GlyphRasterizer::setupLibrary(ft);
+
+    restartRasterizer();
 
     // Adding an empty string at the end to suppress compiler warning
     debugPrint("Font module successfully loaded\n%s", "");
@@ -59,17 +197,19 @@ void terminate() {
     if (!initialized) return;
     initialized = false;
 
-    // Free loaded fonts
-    for (auto &[ttfPath, font] : loadedFonts) {
-        debugPrint("Freeing font at path %s\n", ttfPath.c_str());
+    // Stop workers before their fonts go away
+    rasterizer.reset();
 
-        FT_Error err = FT_Done_Face(font.getFreeTypeFace());
-        if (err != 0) FT_CheckError("FT_Done_Face", err);
-        for (int i = 0; i < CHARS_LEN; ++i) {
-            auto textureID = font.getCharInfo(i).textureID;
-            glDeleteTextures(1, &textureID);
+    // Free fonts still in use, their handles can't be used from now on
+    for (auto &[key, store] : loadedFonts) {
+        if (auto glyphs = store.lock()) {
+            debugPrint("Freeing font at path %s (%gpx)\n", key.ttfPath.c_str(), key.fontHeight);
+            glyphs->release();
         }
     }
+    loadedFonts.clear();
+    glyphStores.clear();
+    mappedFiles.clear();
 
     // Free resources on FreeType library
     if (ft != nullptr) {
@@ -78,118 +218,371 @@ void terminate() {
     }
 }
 
+void setGlyphAtlasBudget(size_t budget) {
+    _glyphAtlasBudget = budget;
+}
+
+size_t glyphAtlasBudget() {
+    return _glyphAtlasBudget;
+}
+
+void setRasterizerThreads(unsigned int numThreads) {
+    if (numThreads == _rasterizerThreads) return;
+    _rasterizerThreads = numThreads;
+
+    if (initialized) restartRasterizer();
+}
+
+unsigned int rasterizerThreads() {
+    return _rasterizerThreads;
+}
+
+std::shared_ptr<const MappedFile> mapFontFile(const std::string &path) {
+    auto it = mappedFiles.find(path);
+    if (it != mappedFiles.end()) {
+        if (auto file = it->second.lock()) return file;
+        mappedFiles.erase(it);
+    }
+
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path)) return nullptr;
+
+    debugPrint("Mapped font file %s (%zu bytes)\n", path.c_str(), file->size());
+    mappedFiles[path] = file;
+    return file;
+}
+
+void uploadRasterizedGlyphs(size_t maxGlyphs) {
+    if (!rasterizer || !rasterizer->hasResults()) return;
+
+    static std::vector<RasterizedGlyph> results;
+    results.clear();
+    rasterizer->collect(results, maxGlyphs);
+
+    for (auto &glyph : results) {
+        // Font may have been destroyed while glyph was rasterized
+        auto store = glyphStores.find(glyph.fontId);
+        if (store == glyphStores.end()) continue;
+        auto glyphs = store->second.lock();
+        if (!glyphs) continue;
+
+        auto it = glyphs->characters.find(glyph.codepoint);
+        if (it == glyphs->characters.end()) continue;
+
+        // Failed glyphs stay pending, so they aren't requested every frame
+        if (!glyph.success) {
+            debugPrint("FREETYPE: Failed to rasterize codepoint U+%04X in background\n", glyph.codepoint);
+            continue;
+        }
+        glyphs->pending.erase(glyph.codepoint);
+
+        // Store bitmap on atlas
+        uint32_t slot = insertGlyph(*glyphs, glyph.codepoint, glyph.bitmap.data(), glyph.size.x, glyph.size.y, glyph.size.x);
+        it->second = Character{
+            glyphs->atlas.texture(slot),
+            glyphs->atlas.uvRect(slot, glyph.size),
+            glyph.size,
+            glyph.bearing,
+            glyph.advance,
+            slot
+        };
+    }
+}
+
 }
 
-Font::Font(const std::string &ttfPath, float fontHeight)
-  : _fontHeight{(float)fontHeight} {
+Font::Font(const std::string &ttfPath, float fontHeight, bool lazy, GlyphRenderMode renderMode) {
     // Check if font is already loaded
-    auto it = loadedFonts.find(ttfPath);
+    const FontKey key{ttfPath, fontHeight, renderMode};
+    auto it = loadedFonts.find(key);
     if (it != loadedFonts.end()) {
-        // Found, avoid reloading resources
-        debugPrint("Font at path %s already loaded, using same resources\n", ttfPath.c_str());
-        *this = it->second;
-        return;
+        // Found, share same resources
+        _glyphs = it->second.lock();
+        if (_glyphs) return;
     }
 
     // Font not loaded yet, try loading resources
-    debugPrint("Font at path %s not loaded yet, loading resources\n", ttfPath.c_str());
+    debugPrint("Font at path %s (%gpx) not loaded yet, loading resources\n", ttfPath.c_str(), fontHeight);
 
-    // Trying to get ttf file to face struct
-    FT_Error err = FT_New_Face(ft, (_rootPath + "/" + ttfPath).c_str(), 0, &_face);
-    if (err != 0) {
-        throw std::runtime_error{FT_Error_String(err)};
+    auto startTime = std::chrono::steady_clock::now();
+
+    _glyphs = std::make_shared<Glyphs>();
+    _glyphs->ttfPath = ttfPath;
+    _glyphs->fontHeight = fontHeight;
+    _glyphs->renderMode = renderMode;
+    _glyphs->id = nextFontId++;
+    _glyphs->path = _rootPath + "/" + ttfPath;
+
+    // Faces read straight from the shared mapping, so the file is only read once for every size
+    _glyphs->file = FontModule::mapFontFile(_glyphs->path);
+
+    // Fonts under resources/ may be embedded in the library instead (see EMBED_FONTS)
+    const std::string resourcesPrefix = "resources/";
+    if (!_glyphs->file && ttfPath.compare(0, resourcesPrefix.size(), resourcesPrefix) == 0) {
+        _glyphs->file = Resources::open(ttfPath.substr(resourcesPrefix.size()));
+    }
+    if (!_glyphs->file) {
+        throw std::runtime_error{"Failed to open font file " + _glyphs->path};
     }
 
-    // Disable byte-alignment restriction
-    // FT char texture will have a pixel every 1 byte (RED) as opposed to every 4 bytes (RGBA)
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); glCheckError();
+    // Use baked font if there's an up to date one, so FreeType isn't needed for its glyphs
+    BakedFont baked;
+    const std::string bakedPath = _rootPath + "/" + BakedFont::pathFor(ttfPath, fontHeight, renderMode);
+    const bool isBaked = baked.load(bakedPath, _glyphs->path, fontHeight, renderMode);
+    _glyphs->metrics = std::make_shared<FontMetrics>(_glyphs->file, fontHeight, isBaked ? &baked : nullptr);
+    if (isBaked) loadBaked(baked);
 
-    // Generate characters from 32 to 126
-    FT_Set_Pixel_Sizes(_face, 0, fontHeight);
-    _maxCharHeight = 0.0f;
-    _maxCharUnderflow = 0.0f;
-    for (int i = 0; i < CHARS_LEN; ++i) {
-        // Attempt to load char
-        FT_Error err = FT_Load_Char(_face, CHARS_START + i, FT_LOAD_RENDER);
-        if (err != 0) {
-            debugPrint("FREETYPE: Failed to load char %c\n", i);
-            FT_CheckError("FT_Load_Char", err);
-            continue;
+    // Preload printable ASCII characters, other ones are loaded on first use
+    // (with background rasterization, this only queues them)
+    if (!lazy) {
+        for (int i = 0; i < CHARS_LEN; ++i) {
+            getGlyph(CHARS_START + i);
         }
+    }
 
-        // Generate texture
-        unsigned int texture;
-        glGenTextures(1, &texture); glCheckError();
-        glBindTexture(GL_TEXTURE_2D, texture); glCheckError();
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            _face->glyph->bitmap.width,
-            _face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            _face->glyph->bitmap.buffer
-        ); glCheckError();
-
-        // Set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,  GL_CLAMP_TO_BORDER); glCheckError();
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,  GL_CLAMP_TO_BORDER); glCheckError();
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); glCheckError();
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); glCheckError();
-
-        // Create character struct from glyph data
-        Character character = {
-            texture,
-            glm::vec2{_face->glyph->bitmap.width, _face->glyph->bitmap.rows},
-            glm::vec2{_face->glyph->bitmap_left, _face->glyph->bitmap_top},
-            (float)(_face->glyph->advance.x >> 6)
-        };
-        _characters[i] = character;
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+    debugPrint(
+        "Font at path %s (%gpx) loaded in %.2fms (%s)\n",
+        ttfPath.c_str(),
+        fontHeight,
+        elapsed.count(),
+        isBaked ? "baked" : lazy ? "lazy" : "eager"
+    );
+
+    // Store font in maps, without keeping it alive
+    loadedFonts[key] = _glyphs;
+    glyphStores[_glyphs->id] = _glyphs;
+}
+
+const Character &Font::getCharInfo(uint32_t codepoint) {
+    return loadCharacter(FontMetrics::normalize(codepoint));
+}
 
-        // Update font info
-        _maxCharUnderflow = std::max(_maxCharUnderflow, character.size.y - character.bearing.y);
-        _maxCharHeight = std::max(_maxCharHeight, character.size.y);
+const Character &Font::getGlyph(uint32_t codepoint) {
+    codepoint = FontMetrics::normalize(codepoint);
+    Character &character = loadCharacter(codepoint);
+
+    // Baked glyphs are always on their atlas
+    if (character.atlasSlot == BAKED_SLOT) return character;
+
+    // Failed glyphs have no texture, so they're skipped when drawn
+    if (character.atlasSlot == FAILED_SLOT) return character;
+
+    // Glyph may have been evicted from the atlas since it was loaded
+    if (!_glyphs->atlas.acquire(character.atlasSlot, codepoint)) {
+        if (rasterizer) {
+            // Don't block, glyph has no texture until rasterized and uploaded
+            character.textureID = 0;
+            if (_glyphs->pending.insert(codepoint).second) {
+                rasterizer->request(GlyphRequest{_glyphs->id, _glyphs->file, _glyphs->fontHeight, _glyphs->renderMode, codepoint});
+            }
+        } else {
+            rasterize(codepoint, character);
+        }
     }
+    return character;
+}
 
-    // Go back to original byte-alignment
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 4); glCheckError();
+Character &Font::loadCharacter(uint32_t codepoint) {
+    // Fast path for ASCII
+    if (codepoint < 128) {
+        Character *character = _glyphs->ascii[codepoint];
+        if (character != nullptr) return *character;
+    } else {
+        auto it = _glyphs->characters.find(codepoint);
+        if (it != _glyphs->characters.end()) return it->second;
+    }
 
-    // Store font in map
-    loadedFonts[ttfPath] = *this;
+    // Not loaded yet (map nodes are stable, so fast path pointers stay valid)
+    Character &character = _glyphs->characters[codepoint];
+    loadMetrics(codepoint, character);
+    if (codepoint < 128) {
+        _glyphs->ascii[codepoint] = &character;
+    }
+    return character;
 }
 
-Character Font::getCharInfo(char c) {
-    // If not a printable character, space ' ' will be used
-    if (c < 32 || c > 126) c = 32;
+void Font::loadMetrics(uint32_t codepoint, Character &character) {
+    // No texture until rasterized
+    const GlyphMetrics &metrics = _glyphs->metrics->get(codepoint);
+    character = Character{
+        0,
+        glm::vec4{0.0f},
+        metrics.size,
+        metrics.bearing,
+        metrics.advance,
+        GlyphAtlas::NO_SLOT
+    };
+}
+
+void Font::rasterize(uint32_t codepoint, Character &character) {
+    // Attempt to load char (missing glyphs will use the face's fallback glyph)
+    FT_Face face = this->face();
+    FT_Error err = GlyphRasterizer::renderGlyph(face, codepoint, _glyphs->renderMode);
+    if (err != 0) {
+        debugPrint("FREETYPE: Failed to load codepoint U+%04X\n", codepoint);
+        FT_CheckError("FT_Load_Char", err);
 
-    return _characters[c - 32];
+        // Like failed background requests, it isn't rasterized again on every lookup
+        character = Character{0, glm::vec4{0.0f}, glm::vec2{0.0f}, glm::vec2{0.0f}, 0.0f, FAILED_SLOT};
+        return;
+    }
+
+    // Store bitmap on atlas
+    const FT_Bitmap &bitmap = face->glyph->bitmap;
+    glm::vec2 size{bitmap.width, bitmap.rows};
+    uint32_t slot = insertGlyph(*_glyphs, codepoint, bitmap.buffer, bitmap.width, bitmap.rows, bitmap.pitch);
+
+    // Create character struct from glyph data
+    character = Character{
+        _glyphs->atlas.texture(slot),
+        _glyphs->atlas.uvRect(slot, size),
+        size,
+        glm::vec2{face->glyph->bitmap_left, face->glyph->bitmap_top},
+        (float)(face->glyph->advance.x >> 6),
+        slot
+    };
+}
+
+void Font::loadBaked(const BakedFont &baked) {
+    const BakedFont::Header &header = baked.header();
+
+    // Upload whole atlas straight from mapped file
+    unsigned int texture;
+    glGenTextures(1, &texture); glCheckError();
+    glBindTexture(GL_TEXTURE_2D, texture); glCheckError();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); glCheckError();
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        GL_R8,
+        header.atlasWidth,
+        header.atlasHeight,
+        0,
+        GL_RED,
+        GL_UNSIGNED_BYTE,
+        baked.pixels()
+    ); glCheckError();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4); glCheckError();
+
+    // Set texture options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); glCheckError();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); glCheckError();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); glCheckError();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); glCheckError();
+    _glyphs->bakedTexture = texture;
+
+    // Baked glyphs never leave the atlas, so their texture data is set once
+    const float invWidth = 1.0f / header.atlasWidth;
+    const float invHeight = 1.0f / header.atlasHeight;
+    for (uint32_t i = 0; i < header.numGlyphs; ++i) {
+        const BakedFont::Glyph &glyph = baked.glyphs()[i];
+        Character &character = _glyphs->characters[glyph.codepoint];
+        character = Character{
+            texture,
+            glm::vec4{glyph.x * invWidth, glyph.y * invHeight, glyph.width * invWidth, glyph.rows * invHeight},
+            glm::vec2{glyph.width, glyph.rows},
+            glm::vec2{glyph.bearingX, glyph.bearingY},
+            glyph.advance,
+            BAKED_SLOT
+        };
+        if (glyph.codepoint < 128) {
+            _glyphs->ascii[glyph.codepoint] = &character;
+        }
+    }
 }
 
-float Font::calculateTextWidth(const std::string &text, float fontSize) {
-    const float scale = fontSize / fontHeight();
-    const float textSize = text.size();
+FT_Face Font::face() const {
+    if (_glyphs->face != nullptr) return _glyphs->face;
 
-    float width = 0;
-    for (size_t i = 0; i < textSize; ++i) {
-        width += getCharInfo(text[i]).advance * scale;
+    // Trying to get ttf file to face struct
+    const auto &file = _glyphs->file;
+    FT_Face face;
+    FT_Error err = FT_New_Memory_Face(ft, file->data(), (FT_Long)file->size(), 0, &face);
+    if (err != 0) {
+        throw std::runtime_error{FT_Error_String(err)};
     }
-    return width;
+    FT_Set_Pixel_Sizes(face, 0, _glyphs->fontHeight);
+
+    _glyphs->face = face;
+    return face;
+}
+
+float Font::getKerning(uint32_t left, uint32_t right) {
+    return _glyphs->metrics->kerning(left, right);
+}
+
+float Font::calculateTextWidth(std::string_view text, float fontSize) {
+    return _glyphs->metrics->textWidth(text, fontSize);
 }
 
 FT_Face Font::getFreeTypeFace() const {
-    return _face;
+    return face();
 }
 
 float Font::fontHeight() const {
-    return _fontHeight;
+    return _glyphs->fontHeight;
+}
+
+GlyphRenderMode Font::renderMode() const {
+    return _glyphs->renderMode;
 }
 
 float Font::maxCharHeight() const {
-    return _maxCharHeight;
+    return _glyphs->metrics->maxCharHeight();
 }
 
 float Font::maxCharUnderflow() const {
-    return _maxCharUnderflow;
-}
\ No newline at end of file
+    return _glyphs->metrics->maxCharUnderflow();
+}
+
+std::shared_ptr<const FontMetrics> Font::metrics() const {
+    return _glyphs->metrics;
+}
+
+bool Font::isLoaded() const {
+    return _glyphs != nullptr;
+}
+
+uint64_t Font::id() const {
+    return _glyphs->id;
+}
+
+long Font::useCount() const {
+    return _glyphs.use_count();
+}
+
+void Font::destroy() {
+    if (_glyphs) _glyphs->release();
+}
+
+Font::Glyphs::~Glyphs() {
+    // Resources were already freed on terminate, along with the GL context
+    if (!initialized) return;
+
+    debugPrint("Freeing font at path %s (%gpx), no handles left\n", ttfPath.c_str(), fontHeight);
+    release();
+
+    // Entries may already belong to a newer font with the same key
+    auto it = loadedFonts.find(FontKey{ttfPath, fontHeight, renderMode});
+    if (it != loadedFonts.end() && it->second.expired()) loadedFonts.erase(it);
+    glyphStores.erase(id);
+}
+
+void Font::Glyphs::release() {
+    if (face != nullptr) {
+        FT_Error err = FT_Done_Face(face);
+        if (err != 0) FT_CheckError("FT_Done_Face", err);
+        face = nullptr;
+    }
+    file.reset();
+    metrics.reset();
+
+    atlas.destroy();
+    if (bakedTexture != 0) {
+        glDeleteTextures(1, &bakedTexture); glCheckError();
+        bakedTexture = 0;
+    }
+
+    if (rasterizer) rasterizer->release(id);
+}
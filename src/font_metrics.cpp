@@ -0,0 +1,273 @@
+#include <stdexcept>
+#include <mutex>
+
+#include "debug.hpp"
+#include "advance_kernels.hpp"
+#include "baked_font.hpp"
+#include "font.hpp"
+#include "font_metrics.hpp"
+#include "mapped_file.hpp"
+#include "utf8.hpp"
+
+const char *FT_Error_String(FT_Error error) {
+    #undef FTERRORS_H_
+    #define FT_ERROR_START_LIST     switch(error) {
+    #define FT_ERRORDEF(e, v, s)    case e:\
+                                        return s;
+    #define FT_ERROR_END_LIST       default:\
+                                        return "Unknown error"; \
+                                    }
+    #include "freetype/fterrors.h"
+}
+
+void FT_CheckError(const std::string &prefix, FT_Error code) {
+    auto str = FT_Error_String(code);
+    debugPrint("[FREETYPE] %s: %s\n", prefix.c_str(), str);
+}
+
+/// @brief Gets key of a kerning pair on kerning map
+/// @param left codepoint on the left
+/// @param right codepoint on the right
+/// @return map key
+static uint64_t kerningKey(uint32_t left, uint32_t right) {
+    return ((uint64_t)left << 32) | right;
+}
+
+/// @brief Maps a font file, throwing if it can't be opened
+/// @param path path to font file
+/// @return mapped file
+static std::shared_ptr<const MappedFile> mapFile(const std::string &path) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path)) {
+        throw std::runtime_error{"Failed to open font file " + path};
+    }
+    return file;
+}
+
+FontMetrics::FontMetrics(std::shared_ptr<const MappedFile> file, float fontHeight, const BakedFont *baked)
+    : _file{std::move(file)}, _fontHeight{fontHeight} {
+    FT_Error err = FT_Init_FreeType(&_library);
+    if (err != 0) {
+        throw std::runtime_error{FT_Error_String(err)};
+    }
+
+    // Baked glyphs and kerning are copied, so the baked file can be closed afterwards
+    if (baked != nullptr) {
+        const BakedFont::Header &header = baked->header();
+        _maxCharHeight = header.maxCharHeight;
+        _maxCharUnderflow = header.maxCharUnderflow;
+
+        for (uint32_t i = 0; i < header.numGlyphs; ++i) {
+            const BakedFont::Glyph &glyph = baked->glyphs()[i];
+            Entry &entry = _entries[glyph.codepoint];
+            entry = Entry{
+                GlyphMetrics{
+                    glm::vec2{glyph.width, glyph.rows},
+                    glm::vec2{glyph.bearingX, glyph.bearingY},
+                    glyph.advance
+                },
+                true
+            };
+            if (glyph.codepoint < 128) _ascii[glyph.codepoint] = &entry;
+        }
+
+        for (uint32_t i = 0; i < header.numKerningPairs; ++i) {
+            const BakedFont::KerningPair &pair = baked->kerningPairs()[i];
+            _kerning[kerningKey(pair.left, pair.right)] = pair.amount;
+        }
+        return;
+    }
+
+    // Font info comes from global face metrics, so no glyph needs to be loaded for it
+    FT_Face face;
+    try {
+        face = this->face();
+    } catch (...) {
+        FT_Done_FreeType(_library);
+        throw;
+    }
+    const FT_Size_Metrics &metrics = face->size->metrics;
+    _maxCharUnderflow = (float)((-metrics.descender + 63) >> 6);
+    _maxCharHeight = (float)((metrics.ascender + 63) >> 6) + _maxCharUnderflow;
+}
+
+FontMetrics::FontMetrics(const std::string &path, float fontHeight) : FontMetrics{mapFile(path), fontHeight} {}
+
+FontMetrics::~FontMetrics() {
+    if (_face != nullptr) {
+        FT_Error err = FT_Done_Face(_face);
+        if (err != 0) FT_CheckError("FT_Done_Face", err);
+    }
+    if (_library != nullptr) {
+        FT_Error err = FT_Done_FreeType(_library);
+        if (err != 0) FT_CheckError("FT_Done_FreeType", err);
+    }
+}
+
+const GlyphMetrics &FontMetrics::get(uint32_t codepoint) const {
+    return entry(normalize(codepoint)).metrics;
+}
+
+const FontMetrics::Entry &FontMetrics::entry(uint32_t codepoint) const {
+    // Fast path for ASCII, without locking
+    if (codepoint < 128) {
+        const Entry *entry = _ascii[codepoint].load(std::memory_order_acquire);
+        if (entry != nullptr) return *entry;
+    } else {
+        std::shared_lock lock{_mutex};
+        auto it = _entries.find(codepoint);
+        if (it != _entries.end()) return it->second;
+    }
+
+    // Not loaded yet, another thread may have loaded it in the meantime
+    std::unique_lock lock{_mutex};
+    auto it = _entries.find(codepoint);
+    if (it != _entries.end()) return it->second;
+
+    // Loading without rendering only scales and hints the outline
+    Entry &entry = _entries[codepoint];
+    entry = Entry{GlyphMetrics{glm::vec2{0.0f}, glm::vec2{0.0f}, 0.0f}, false};
+    FT_Face face = this->face();
+    FT_Error err = FT_Load_Char(face, codepoint, FT_LOAD_DEFAULT);
+    if (err != 0) {
+        debugPrint("FREETYPE: Failed to load codepoint U+%04X\n", codepoint);
+        FT_CheckError("FT_Load_Char", err);
+    } else {
+        const FT_Glyph_Metrics &metrics = face->glyph->metrics;
+        entry.metrics = GlyphMetrics{
+            glm::vec2{metrics.width >> 6, metrics.height >> 6},
+            glm::vec2{metrics.horiBearingX >> 6, metrics.horiBearingY >> 6},
+            (float)(face->glyph->advance.x >> 6)
+        };
+    }
+
+    if (codepoint < 128) _ascii[codepoint].store(&entry, std::memory_order_release);
+    return entry;
+}
+
+float FontMetrics::advance(uint32_t codepoint) const {
+    if (codepoint < 128) return asciiAdvances()[codepoint];
+    return get(codepoint).advance;
+}
+
+float FontMetrics::kerning(uint32_t left, uint32_t right) const {
+    left = normalize(left);
+    right = normalize(right);
+
+    // Baked kerning has every non-zero pair of baked glyphs
+    if (entry(left).baked && entry(right).baked) {
+        auto it = _kerning.find(kerningKey(left, right));
+        return it != _kerning.end() ? it->second : 0.0f;
+    }
+
+    std::unique_lock lock{_mutex};
+    FT_Face face = this->face();
+    if (!FT_HAS_KERNING(face)) return 0.0f;
+
+    FT_Vector kerning;
+    FT_Error err = FT_Get_Kerning(
+        face,
+        FT_Get_Char_Index(face, left),
+        FT_Get_Char_Index(face, right),
+        FT_KERNING_DEFAULT,
+        &kerning
+    );
+    return err == 0 ? (float)(kerning.x >> 6) : 0.0f;
+}
+
+float FontMetrics::textWidth(std::string_view text, float fontSize) const {
+    const float *table = asciiAdvances();
+    const unsigned char *bytes = (const unsigned char *)text.data();
+    const size_t size = text.size();
+
+    // Advances are summed at font height and scaled once, ASCII runs go through the kernel
+    float width = 0.0f;
+    size_t i = 0;
+    while (true) {
+        i += AdvanceKernels::sumAscii(table, bytes + i, size - i, width);
+        if (i == size) break;
+
+        auto it = text.begin() + i;
+        width += get(decodeUtf8(it, text.end())).advance;
+        i = it - text.begin();
+    }
+    return width * (fontSize / _fontHeight);
+}
+
+void FontMetrics::prefixWidths(std::string_view text, float fontSize, float *out) const {
+    const float *table = asciiAdvances();
+    const unsigned char *bytes = (const unsigned char *)text.data();
+    const size_t size = text.size();
+    const float scale = fontSize / _fontHeight;
+
+    float width = 0.0f;
+    size_t i = 0;
+    out[0] = 0.0f;
+    while (true) {
+        i += AdvanceKernels::prefixAscii(table, bytes + i, size - i, width, scale, out + i + 1);
+        if (i == size) break;
+
+        // Bytes inside a multi-byte codepoint don't include it yet
+        auto it = text.begin() + i;
+        const uint32_t codepoint = decodeUtf8(it, text.end());
+        const size_t next = it - text.begin();
+        for (size_t j = i + 1; j < next; ++j) {
+            out[j] = width * scale;
+        }
+        width += get(codepoint).advance;
+        out[next] = width * scale;
+        i = next;
+    }
+}
+
+glm::ivec2 FontMetrics::glyphBounds() const {
+    std::unique_lock lock{_mutex};
+    FT_Face face = this->face();
+    const FT_Size_Metrics &metrics = face->size->metrics;
+    if (FT_IS_SCALABLE(face)) {
+        return glm::ivec2{
+            (FT_MulFix(face->bbox.xMax - face->bbox.xMin, metrics.x_scale) + 63) >> 6,
+            (FT_MulFix(face->bbox.yMax - face->bbox.yMin, metrics.y_scale) + 63) >> 6
+        };
+    }
+    return glm::ivec2{metrics.max_advance >> 6, metrics.height >> 6};
+}
+
+float FontMetrics::fontHeight() const {
+    return _fontHeight;
+}
+
+float FontMetrics::maxCharHeight() const {
+    return _maxCharHeight;
+}
+
+float FontMetrics::maxCharUnderflow() const {
+    return _maxCharUnderflow;
+}
+
+const float *FontMetrics::asciiAdvances() const {
+    std::call_once(_advancesOnce, [this]() {
+        for (uint32_t codepoint = 0; codepoint < 128; ++codepoint) {
+            _advances[codepoint] = get(codepoint).advance;
+        }
+    });
+    return _advances;
+}
+
+uint32_t FontMetrics::normalize(uint32_t codepoint) {
+    // Control characters are drawn as spaces
+    if (codepoint < CHARS_START || codepoint == 127) return ' ';
+    return codepoint;
+}
+
+FT_Face FontMetrics::face() const {
+    if (_face != nullptr) return _face;
+
+    FT_Error err = FT_New_Memory_Face(_library, _file->data(), (FT_Long)_file->size(), 0, &_face);
+    if (err != 0) {
+        _face = nullptr;
+        throw std::runtime_error{FT_Error_String(err)};
+    }
+    FT_Set_Pixel_Sizes(_face, 0, _fontHeight);
+    return _face;
+}
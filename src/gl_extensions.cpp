@@ -0,0 +1,69 @@
+#include <cstring>
+
+#include "debug.hpp"
+#include "gl_extensions.hpp"
+
+#include <GLFW/glfw3.h>
+
+namespace GLExtensions {
+
+void (APIENTRYP getProgramBinary)(GLuint, GLsizei, GLsizei *, GLenum *, void *) = nullptr;
+void (APIENTRYP programBinary)(GLuint, GLenum, const void *, GLsizei) = nullptr;
+void (APIENTRYP programParameteri)(GLuint, GLenum, GLint) = nullptr;
+void (APIENTRYP maxShaderCompilerThreads)(GLuint) = nullptr;
+
+/// @brief Whether driver has at least one program binary format
+static bool _hasBinaryFormats = false;
+
+/// @brief Whether context has a given extension
+/// @param name extension name
+/// @return whether extension is supported
+static bool hasExtension(const char *name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count); glCheckError();
+    for (GLint i = 0; i < count; ++i) {
+        const char *extension = (const char *)glGetStringi(GL_EXTENSIONS, i); glCheckError();
+        if (extension != nullptr && std::strcmp(extension, name) == 0) return true;
+    }
+    return false;
+}
+
+void load() {
+    // Core since 4.1, same entry points as the ARB extension
+    const bool coreBinary = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 1);
+    if (coreBinary || hasExtension("GL_ARB_get_program_binary")) {
+        getProgramBinary = (decltype(getProgramBinary))glfwGetProcAddress("glGetProgramBinary");
+        programBinary = (decltype(programBinary))glfwGetProcAddress("glProgramBinary");
+        programParameteri = (decltype(programParameteri))glfwGetProcAddress("glProgramParameteri");
+
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats); glCheckError();
+        _hasBinaryFormats = numFormats > 0;
+    }
+
+    // Both extensions have the same enums, ARB just came later
+    if (hasExtension("GL_KHR_parallel_shader_compile")) {
+        maxShaderCompilerThreads = (decltype(maxShaderCompilerThreads))glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+    }
+    else if (hasExtension("GL_ARB_parallel_shader_compile")) {
+        maxShaderCompilerThreads = (decltype(maxShaderCompilerThreads))glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+    }
+
+    // Let the driver use as many compiler threads as it wants
+    if (maxShaderCompilerThreads != nullptr) {
+        maxShaderCompilerThreads(0xFFFFFFFF); glCheckError();
+    }
+
+    debugPrint("Program binaries %s\n", hasProgramBinary() ? "supported" : "not supported");
+    debugPrint("Parallel shader compile %s\n", hasParallelShaderCompile() ? "supported" : "not supported");
+}
+
+bool hasProgramBinary() {
+    return _hasBinaryFormats && getProgramBinary != nullptr && programBinary != nullptr && programParameteri != nullptr;
+}
+
+bool hasParallelShaderCompile() {
+    return maxShaderCompilerThreads != nullptr;
+}
+
+} // GLExtensions
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <cstring>
+
+#include "glad/glad.h"
+
+#include "debug.hpp"
+#include "glyph_atlas.hpp"
+
+/// @brief Empty pixels around each glyph, so linear filtering doesn't bleed into neighbours
+static constexpr int CELL_PADDING = 1;
+
+GlyphAtlas::GlyphAtlas(const glm::ivec2 &cellSize, size_t budget) {
+    // Cells can't be bigger than a page
+    _cellSize = glm::ivec2{
+        std::clamp(cellSize.x + 2 * CELL_PADDING, 1 + 2 * CELL_PADDING, GLYPH_ATLAS_PAGE_SIZE),
+        std::clamp(cellSize.y + 2 * CELL_PADDING, 1 + 2 * CELL_PADDING, GLYPH_ATLAS_PAGE_SIZE)
+    };
+    _cellsPerRow = GLYPH_ATLAS_PAGE_SIZE / _cellSize.x;
+    _cellsPerPage = _cellsPerRow * (GLYPH_ATLAS_PAGE_SIZE / _cellSize.y);
+
+    const size_t pageBytes = GLYPH_ATLAS_PAGE_SIZE * GLYPH_ATLAS_PAGE_SIZE;
+    _maxPages = std::max<size_t>(1, budget / pageBytes);
+}
+
+bool GlyphAtlas::full() const {
+    return _keys.size() >= _pages.size() * _cellsPerPage && _pages.size() >= _maxPages;
+}
+
+uint32_t GlyphAtlas::insert(uint32_t key, const unsigned char *bitmap, int width, int rows, int pitch) {
+    // Find a slot: a free one if any, else one on a new page, else the least recently used one
+    uint32_t slot;
+    if (_keys.size() < _pages.size() * _cellsPerPage) {
+        slot = _keys.size();
+    } else if (_pages.size() < _maxPages) {
+        addPage();
+        slot = _keys.size();
+    } else {
+        slot = _tail;
+        unlink(slot);
+        debugPrint("Glyph atlas full, evicting glyph %u for %u\n", _keys[slot], key);
+    }
+
+    if (slot == _keys.size()) {
+        _keys.push_back(key);
+        _prev.push_back(NO_SLOT);
+        _next.push_back(NO_SLOT);
+    }
+    _keys[slot] = key;
+    moveToFront(slot);
+
+    // Copy bitmap to a zeroed cell-sized buffer, so previous glyph pixels and padding are cleared
+    width = std::clamp(width, 0, _cellSize.x - 2 * CELL_PADDING);
+    rows = std::clamp(rows, 0, _cellSize.y - 2 * CELL_PADDING);
+    std::vector<unsigned char> cell(_cellSize.x * _cellSize.y, 0);
+    for (int y = 0; y < rows; ++y) {
+        std::memcpy(
+            &cell[(y + CELL_PADDING) * _cellSize.x + CELL_PADDING],
+            bitmap + y * pitch,
+            width
+        );
+    }
+
+    // Upload cell
+    const uint32_t cellIdx = slot % _cellsPerPage;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); glCheckError();
+    glBindTexture(GL_TEXTURE_2D, texture(slot)); glCheckError();
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        (cellIdx % _cellsPerRow) * _cellSize.x,
+        (cellIdx / _cellsPerRow) * _cellSize.y,
+        _cellSize.x,
+        _cellSize.y,
+        GL_RED,
+        GL_UNSIGNED_BYTE,
+        cell.data()
+    ); glCheckError();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4); glCheckError();
+
+    return slot;
+}
+
+bool GlyphAtlas::acquire(uint32_t slot, uint32_t key) {
+    if (slot >= _keys.size() || _keys[slot] != key) return false;
+
+    moveToFront(slot);
+    return true;
+}
+
+unsigned int GlyphAtlas::texture(uint32_t slot) const {
+    return _pages[slot / _cellsPerPage];
+}
+
+glm::vec4 GlyphAtlas::uvRect(uint32_t slot, const glm::vec2 &size) const {
+    const uint32_t cellIdx = slot % _cellsPerPage;
+    const float invPageSize = 1.0f / GLYPH_ATLAS_PAGE_SIZE;
+    return glm::vec4{
+        ((cellIdx % _cellsPerRow) * _cellSize.x + CELL_PADDING) * invPageSize,
+        ((cellIdx / _cellsPerRow) * _cellSize.y + CELL_PADDING) * invPageSize,
+        size.x * invPageSize,
+        size.y * invPageSize
+    };
+}
+
+glm::ivec2 GlyphAtlas::cellSize() const {
+    return _cellSize;
+}
+
+uint32_t GlyphAtlas::capacity() const {
+    return _maxPages * _cellsPerPage;
+}
+
+uint32_t GlyphAtlas::size() const {
+    return _keys.size();
+}
+
+void GlyphAtlas::destroy() {
+    if (!_pages.empty()) {
+        glDeleteTextures(_pages.size(), _pages.data()); glCheckError();
+    }
+    _pages.clear();
+    _keys.clear();
+    _prev.clear();
+    _next.clear();
+    _head = NO_SLOT;
+    _tail = NO_SLOT;
+}
+
+void GlyphAtlas::addPage() {
+    // Pages start zeroed, so sampling empty space gives no coverage
+    std::vector<unsigned char> pixels(GLYPH_ATLAS_PAGE_SIZE * GLYPH_ATLAS_PAGE_SIZE, 0);
+
+    unsigned int texture;
+    glGenTextures(1, &texture); glCheckError();
+    glBindTexture(GL_TEXTURE_2D, texture); glCheckError();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); glCheckError();
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        GL_R8,
+        GLYPH_ATLAS_PAGE_SIZE,
+        GLYPH_ATLAS_PAGE_SIZE,
+        0,
+        GL_RED,
+        GL_UNSIGNED_BYTE,
+        pixels.data()
+    ); glCheckError();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4); glCheckError();
+
+    // Set texture options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); glCheckError();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); glCheckError();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); glCheckError();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); glCheckError();
+
+    _pages.push_back(texture);
+    debugPrint("Glyph atlas page %zu allocated\n", _pages.size());
+}
+
+void GlyphAtlas::moveToFront(uint32_t slot) {
+    if (_head == slot) return;
+    unlink(slot);
+
+    _prev[slot] = NO_SLOT;
+    _next[slot] = _head;
+    if (_head != NO_SLOT) _prev[_head] = slot;
+    _head = slot;
+    if (_tail == NO_SLOT) _tail = slot;
+}
+
+void GlyphAtlas::unlink(uint32_t slot) {
+    const uint32_t prev = _prev[slot];
+    const uint32_t next = _next[slot];
+
+    if (prev != NO_SLOT) _next[prev] = next;
+    else if (_head == slot) _head = next;
+
+    if (next != NO_SLOT) _prev[next] = prev;
+    else if (_tail == slot) _tail = prev;
+
+    _prev[slot] = NO_SLOT;
+    _next[slot] = NO_SLOT;
+}
@@ -0,0 +1,175 @@
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+#include "freetype/ft2build.h"
+#include FT_FREETYPE_H
+#include FT_MODULE_H
+
+#include "debug.hpp"
+#include "glyph_rasterizer.hpp"
+
+GlyphRasterizer::GlyphRasterizer(unsigned int numThreads) {
+    if (numThreads == 0) numThreads = 1;
+    for (unsigned int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back(&GlyphRasterizer::work, this);
+    }
+    debugPrint("Glyph rasterizer started with %u threads\n", numThreads);
+}
+
+GlyphRasterizer::~GlyphRasterizer() {
+    {
+        std::lock_guard<std::mutex> lock{_requestsMutex};
+        _stop = true;
+    }
+    _requestsCondition.notify_all();
+
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+}
+
+void GlyphRasterizer::request(GlyphRequest request) {
+    {
+        std::lock_guard<std::mutex> lock{_requestsMutex};
+        _requests.push_back(std::move(request));
+    }
+    _requestsCondition.notify_one();
+}
+
+size_t GlyphRasterizer::collect(std::vector<RasterizedGlyph> &out, size_t max) {
+    if (!hasResults()) return 0;
+
+    std::lock_guard<std::mutex> lock{_resultsMutex};
+    size_t count = std::min(max, _results.size());
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(std::move(_results.front()));
+        _results.pop_front();
+    }
+    _numResults = _results.size();
+    return count;
+}
+
+bool GlyphRasterizer::hasResults() const {
+    return _numResults.load(std::memory_order_relaxed) > 0;
+}
+
+void GlyphRasterizer::release(uint64_t fontId) {
+    {
+        std::lock_guard<std::mutex> lock{_requestsMutex};
+        _released.push_back(fontId);
+
+        // Drop queued requests, so no worker opens the font again
+        _requests.erase(
+            std::remove_if(
+                _requests.begin(),
+                _requests.end(),
+                [fontId](const GlyphRequest &request) { return request.fontId == fontId; }
+            ),
+            _requests.end()
+        );
+    }
+    _requestsCondition.notify_all();
+}
+
+unsigned int GlyphRasterizer::numThreads() const {
+    return _threads.size();
+}
+
+FT_Error GlyphRasterizer::renderGlyph(FT_Face face, uint32_t codepoint, GlyphRenderMode renderMode) {
+    if (renderMode == GlyphRenderMode::bitmap) {
+        return FT_Load_Char(face, codepoint, FT_LOAD_RENDER);
+    }
+
+    FT_Error err = FT_Load_Char(face, codepoint, FT_LOAD_DEFAULT);
+    if (err != 0) return err;
+
+    // Glyphs without outline (like spaces) have nothing to measure distance to
+    if (face->glyph->format == FT_GLYPH_FORMAT_OUTLINE && face->glyph->outline.n_points == 0) {
+        face->glyph->bitmap.width = 0;
+        face->glyph->bitmap.rows = 0;
+        return 0;
+    }
+    return FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF);
+}
+
+void GlyphRasterizer::setupLibrary(FT_Library library) {
+    // Make distance field range independent from FreeType defaults
+    FT_Int spread = SDF_SPREAD;
+    FT_Property_Set(library, "sdf", "spread", &spread);
+    FT_Property_Set(library, "bsdf", "spread", &spread);
+}
+
+void GlyphRasterizer::work() {
+    // Each worker owns its FreeType objects
+    FT_Library library;
+    if (FT_Init_FreeType(&library) != 0) {
+        debugPrint("Glyph rasterizer worker failed to initialize FreeType\n%s", "");
+        return;
+    }
+    setupLibrary(library);
+    // Faces by font, keeping their mapped file alive
+    std::unordered_map<uint64_t, std::pair<FT_Face, std::shared_ptr<const MappedFile>>> faces;
+    size_t handledReleases = 0;
+
+    while (true) {
+        GlyphRequest request;
+        {
+            std::unique_lock<std::mutex> lock{_requestsMutex};
+            _requestsCondition.wait(lock, [&]() {
+                return _stop || !_requests.empty() || handledReleases < _released.size();
+            });
+            if (_stop) break;
+
+            // Close faces of released fonts
+            for (; handledReleases < _released.size(); ++handledReleases) {
+                auto it = faces.find(_released[handledReleases]);
+                if (it != faces.end()) {
+                    FT_Done_Face(it->second.first);
+                    faces.erase(it);
+                }
+            }
+            if (_requests.empty()) continue;
+
+            request = std::move(_requests.front());
+            _requests.pop_front();
+        }
+
+        RasterizedGlyph result{request.fontId, request.codepoint, false, {}, glm::vec2{0.0f}, glm::vec2{0.0f}, 0.0f};
+
+        // Open face on first request from this font
+        auto it = faces.find(request.fontId);
+        if (it == faces.end() && request.file) {
+            FT_Face face;
+            const MappedFile &file = *request.file;
+            if (FT_New_Memory_Face(library, file.data(), (FT_Long)file.size(), 0, &face) == 0) {
+                FT_Set_Pixel_Sizes(face, 0, request.fontHeight);
+                it = faces.emplace(request.fontId, std::make_pair(face, request.file)).first;
+            }
+        }
+
+        // Rasterize and copy bitmap, packing rows tightly
+        if (it != faces.end() && renderGlyph(it->second.first, request.codepoint, request.renderMode) == 0) {
+            const FT_GlyphSlot glyph = it->second.first->glyph;
+            const FT_Bitmap &bitmap = glyph->bitmap;
+
+            result.success = true;
+            result.bitmap.resize(bitmap.width * bitmap.rows);
+            for (unsigned int y = 0; y < bitmap.rows; ++y) {
+                std::memcpy(&result.bitmap[y * bitmap.width], bitmap.buffer + y * bitmap.pitch, bitmap.width);
+            }
+            result.size = glm::vec2{bitmap.width, bitmap.rows};
+            result.bearing = glm::vec2{glyph->bitmap_left, glyph->bitmap_top};
+            result.advance = (float)(glyph->advance.x >> 6);
+        }
+
+        std::lock_guard<std::mutex> lock{_resultsMutex};
+        _results.push_back(std::move(result));
+        _numResults = _results.size();
+    }
+
+    for (auto &[fontId, face] : faces) {
+        FT_Done_Face(face.first);
+    }
+    FT_Done_FreeType(library);
+}
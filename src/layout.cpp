@@ -0,0 +1,345 @@
+#include <algorithm>
+
+#include "dim_kernels.hpp"
+#include "layout.hpp"
+
+/// @brief Floats per child in packed coefficient arrays, size (x, y) then position (x, y)
+static constexpr size_t CHILD_STRIDE = 4;
+
+LayoutNode::~LayoutNode() {
+    if (_parent) _parent->removeChild(this);
+    for (LayoutNode *child : _children) {
+        child->_parent = nullptr;
+        child->_dirty = true;
+    }
+}
+
+void LayoutNode::setPosition(const Dim2 &position) {
+    _position = position;
+    writeCoefficients();
+    markDirty();
+}
+
+Dim2 LayoutNode::position() const {
+    return _position;
+}
+
+void LayoutNode::setAnchorPoint(const glm::vec2 &anchorPoint) {
+    _anchorPoint = anchorPoint;
+    markDirty();
+}
+
+glm::vec2 LayoutNode::anchorPoint() const {
+    return _anchorPoint;
+}
+
+void LayoutNode::setSize(const Dim2 &size) {
+    _size = size;
+    writeCoefficients();
+    markDirty();
+}
+
+Dim2 LayoutNode::size() const {
+    return _size;
+}
+
+void LayoutNode::setGrow(float grow) {
+    _grow = std::max(0.0f, grow);
+    markDirty();
+}
+
+float LayoutNode::grow() const {
+    return _grow;
+}
+
+void LayoutNode::setDirection(LayoutDirection direction) {
+    _direction = direction;
+    markChildrenDirty();
+}
+
+LayoutDirection LayoutNode::direction() const {
+    return _direction;
+}
+
+void LayoutNode::setGap(const Dim &gap) {
+    _gap = gap;
+    markChildrenDirty();
+}
+
+Dim LayoutNode::gap() const {
+    return _gap;
+}
+
+void LayoutNode::setPadding(const Dim2 &padding) {
+    _padding = padding;
+    markChildrenDirty();
+}
+
+Dim2 LayoutNode::padding() const {
+    return _padding;
+}
+
+void LayoutNode::setAlignItems(LayoutAlign align) {
+    _alignItems = align;
+    markChildrenDirty();
+}
+
+LayoutAlign LayoutNode::alignItems() const {
+    return _alignItems;
+}
+
+void LayoutNode::setJustifyContent(LayoutJustify justify) {
+    _justifyContent = justify;
+    markChildrenDirty();
+}
+
+LayoutJustify LayoutNode::justifyContent() const {
+    return _justifyContent;
+}
+
+void LayoutNode::addChild(LayoutNode *child) {
+    if (child == nullptr || child == this) return;
+    if (child->_parent) child->_parent->removeChild(child);
+
+    child->_parent = this;
+    child->_index = _children.size();
+    _children.push_back(child);
+    _childPixels.resize(_children.size() * CHILD_STRIDE);
+    _childScales.resize(_children.size() * CHILD_STRIDE);
+    child->writeCoefficients();
+    child->markDirty();
+}
+
+void LayoutNode::removeChild(LayoutNode *child) {
+    if (child == nullptr || child->_parent != this) return;
+
+    const size_t index = child->_index;
+    _children.erase(_children.begin() + index);
+    _childPixels.erase(_childPixels.begin() + index * CHILD_STRIDE, _childPixels.begin() + (index + 1) * CHILD_STRIDE);
+    _childScales.erase(_childScales.begin() + index * CHILD_STRIDE, _childScales.begin() + (index + 1) * CHILD_STRIDE);
+    for (size_t i = index; i < _children.size(); ++i) _children[i]->_index = i;
+    _scaledChildrenStale = true;
+
+    child->_parent = nullptr;
+    child->_index = 0;
+    child->_dirty = true;
+
+    // Siblings may move or grow into the freed space
+    _childrenDirty = true;
+    markDescendantDirty();
+}
+
+LayoutNode *LayoutNode::parent() const {
+    return _parent;
+}
+
+const std::vector<LayoutNode *> &LayoutNode::children() const {
+    return _children;
+}
+
+size_t LayoutNode::update(const glm::vec2 &containerSize) {
+    if (!isDirty() && containerSize == _containerSize) return 0;
+    _containerSize = containerSize;
+
+    glm::vec2 size, topLeft;
+    resolveAbsolute(containerSize, size, topLeft);
+
+    size_t visited = 0;
+    place(size, topLeft, visited);
+    return visited;
+}
+
+bool LayoutNode::isDirty() const {
+    return _dirty || _childrenDirty || _descendantDirty;
+}
+
+glm::vec2 LayoutNode::computedPosition() const {
+    return _computedPosition;
+}
+
+glm::vec2 LayoutNode::computedSize() const {
+    return _computedSize;
+}
+
+void LayoutNode::markDirty() {
+    _dirty = true;
+    if (_parent) {
+        _parent->_childrenDirty = true;
+        _parent->markDescendantDirty();
+    }
+}
+
+void LayoutNode::markChildrenDirty() {
+    _childrenDirty = true;
+    markDescendantDirty();
+}
+
+void LayoutNode::markDescendantDirty() {
+    for (LayoutNode *node = this; node != nullptr && !node->_descendantDirty; node = node->_parent) {
+        node->_descendantDirty = true;
+    }
+}
+
+void LayoutNode::writeCoefficients() {
+    if (_parent == nullptr) return;
+
+    float *pixels = _parent->_childPixels.data() + _index * CHILD_STRIDE;
+    float *scales = _parent->_childScales.data() + _index * CHILD_STRIDE;
+    const Dim dims[CHILD_STRIDE] = {_size.x(), _size.y(), _position.x(), _position.y()};
+    for (size_t i = 0; i < CHILD_STRIDE; ++i) {
+        pixels[i] = (float)dims[i].pixels();
+        scales[i] = dims[i].scale();
+    }
+    _parent->_scaledChildrenStale = true;
+}
+
+void LayoutNode::resolveAbsolute(const glm::vec2 &containerSize, glm::vec2 &size, glm::vec2 &topLeft) const {
+    size = glm::max(_size.toPixels(containerSize), glm::vec2{0.0f});
+    topLeft = _position.toPixels(containerSize) - size * _anchorPoint;
+}
+
+void LayoutNode::place(const glm::vec2 &size, const glm::vec2 &position, size_t &visited) {
+    ++visited;
+    const bool resized = size != _computedSize;
+    _computedSize = size;
+    _computedPosition = position;
+
+    if (_dirty || _childrenDirty || (resized && !resizeKeepsPixelChildren())) {
+        // Children are placed relative to this node, so only a new size or style reaches them
+        arrangeChildren(visited);
+    }
+    else {
+        // Children made only of pixels keep their rectangle on a resize
+        if (resized) arrangeScaledChildren(visited);
+
+        if (_descendantDirty) {
+            // Remaining children keep their rectangle, only go down to the ones with work below them
+            for (LayoutNode *child : _children) {
+                if (child->_childrenDirty || child->_descendantDirty) {
+                    child->place(child->_computedSize, child->_computedPosition, visited);
+                }
+            }
+        }
+    }
+
+    _dirty = false;
+    _childrenDirty = false;
+    _descendantDirty = false;
+}
+
+void LayoutNode::resolveChildren(glm::vec2 &padding, glm::vec2 &content) {
+    padding = glm::max(_padding.toPixels(_computedSize), glm::vec2{0.0f});
+    content = glm::max(_computedSize - padding * 2.0f, glm::vec2{0.0f});
+
+    _childResolved.resize(_childPixels.size());
+    DimKernels::resolve(
+        _childPixels.data(), _childScales.data(), _childPixels.size() / 2,
+        content.x, content.y, _childResolved.data()
+    );
+}
+
+void LayoutNode::arrangeChildren(size_t &visited) {
+    if (_children.empty()) return;
+
+    glm::vec2 padding, content;
+    resolveChildren(padding, content);
+
+    if (_direction == LayoutDirection::none) {
+        for (size_t i = 0; i < _children.size(); ++i) {
+            const float *resolved = _childResolved.data() + i * CHILD_STRIDE;
+            LayoutNode *child = _children[i];
+            const glm::vec2 size = glm::max(glm::vec2{resolved[0], resolved[1]}, glm::vec2{0.0f});
+            const glm::vec2 topLeft = glm::vec2{resolved[2], resolved[3]} - size * child->_anchorPoint;
+            child->place(size, padding + topLeft, visited);
+        }
+        return;
+    }
+
+    const int main = _direction == LayoutDirection::row ? 0 : 1;
+    const int cross = 1 - main;
+    const float gap = _gap.toPixels(content[main]);
+
+    // Own sizes first, to know how much space is left to grow into or distribute
+    float total = gap * (float)(_children.size() - 1);
+    float totalGrow = 0.0f;
+    for (size_t i = 0; i < _children.size(); ++i) {
+        total += std::max(_childResolved[i * CHILD_STRIDE + main], 0.0f);
+        totalGrow += _children[i]->_grow;
+    }
+    const float freeSpace = content[main] - total;
+    const float growUnit = freeSpace > 0.0f && totalGrow > 0.0f ? freeSpace / totalGrow : 0.0f;
+    const float leftover = growUnit > 0.0f ? 0.0f : freeSpace;
+
+    float cursor = 0.0f;
+    float spacing = gap;
+    switch (_justifyContent) {
+        case LayoutJustify::start:
+            break;
+        case LayoutJustify::center:
+            cursor = leftover * 0.5f;
+            break;
+        case LayoutJustify::end:
+            cursor = leftover;
+            break;
+        case LayoutJustify::spaceBetween:
+            if (_children.size() > 1 && leftover > 0.0f) spacing += leftover / (float)(_children.size() - 1);
+            break;
+    }
+
+    for (size_t i = 0; i < _children.size(); ++i) {
+        const float *resolved = _childResolved.data() + i * CHILD_STRIDE;
+        LayoutNode *child = _children[i];
+        glm::vec2 size = glm::max(glm::vec2{resolved[0], resolved[1]}, glm::vec2{0.0f});
+        size[main] += child->_grow * growUnit;
+        if (_alignItems == LayoutAlign::stretch) size[cross] = content[cross];
+
+        glm::vec2 position;
+        position[main] = cursor;
+        switch (_alignItems) {
+            case LayoutAlign::start:
+            case LayoutAlign::stretch:
+                position[cross] = 0.0f;
+                break;
+            case LayoutAlign::center:
+                position[cross] = (content[cross] - size[cross]) * 0.5f;
+                break;
+            case LayoutAlign::end:
+                position[cross] = content[cross] - size[cross];
+                break;
+        }
+
+        child->place(size, padding + position, visited);
+        cursor += size[main] + spacing;
+    }
+}
+
+bool LayoutNode::resizeKeepsPixelChildren() const {
+    return _direction == LayoutDirection::none && _padding.x().scale() == 0.0f && _padding.y().scale() == 0.0f;
+}
+
+void LayoutNode::arrangeScaledChildren(size_t &visited) {
+    if (_children.empty()) return;
+
+    if (_scaledChildrenStale) {
+        _scaledChildren.clear();
+        for (size_t i = 0; i < _children.size(); ++i) {
+            const float *scales = _childScales.data() + i * CHILD_STRIDE;
+            if (scales[0] != 0.0f || scales[1] != 0.0f || scales[2] != 0.0f || scales[3] != 0.0f) {
+                _scaledChildren.push_back(i);
+            }
+        }
+        _scaledChildrenStale = false;
+    }
+    if (_scaledChildren.empty()) return;
+
+    glm::vec2 padding, content;
+    resolveChildren(padding, content);
+
+    for (size_t i : _scaledChildren) {
+        const float *resolved = _childResolved.data() + i * CHILD_STRIDE;
+        LayoutNode *child = _children[i];
+        const glm::vec2 size = glm::max(glm::vec2{resolved[0], resolved[1]}, glm::vec2{0.0f});
+        const glm::vec2 topLeft = glm::vec2{resolved[2], resolved[3]} - size * child->_anchorPoint;
+        child->place(size, padding + topLeft, visited);
+    }
+}
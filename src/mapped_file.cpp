@@ -0,0 +1,116 @@
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "mapped_file.hpp"
+
+MappedFile::MappedFile(const std::string &path) {
+    open(path);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator= (MappedFile &&other) noexcept {
+    if (this == &other) return *this;
+    close();
+
+    _size = other._size;
+    _mapped = other._mapped;
+    _borrowed = other._borrowed;
+    _open = other._open;
+    _buffer = std::move(other._buffer);
+    _data = _mapped || _borrowed ? other._data : _buffer.data();
+
+    other._data = nullptr;
+    other._size = 0;
+    other._mapped = false;
+    other._borrowed = false;
+    other._open = false;
+    return *this;
+}
+
+bool MappedFile::open(const std::string &path) {
+    close();
+
+#ifdef MAPPED_FILE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // Empty files can't be mapped
+    if (info.st_size > 0) {
+        void *data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            _data = (const unsigned char *)data;
+            _size = info.st_size;
+            _mapped = true;
+        }
+    }
+    ::close(fd);
+    if (_mapped) return _open = true;
+#endif
+
+    // Fall back to reading the whole file
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+    if (!file) return false;
+
+    _buffer.resize(file.tellg());
+    file.seekg(0);
+    if (!file.read((char *)_buffer.data(), _buffer.size())) {
+        _buffer.clear();
+        return false;
+    }
+    _data = _buffer.data();
+    _size = _buffer.size();
+    return _open = true;
+}
+
+void MappedFile::view(const unsigned char *data, size_t size) {
+    close();
+    _data = data;
+    _size = size;
+    _borrowed = true;
+    _open = true;
+}
+
+void MappedFile::close() {
+#ifdef MAPPED_FILE_MMAP
+    if (_mapped) munmap((void *)_data, _size);
+#endif
+    _data = nullptr;
+    _size = 0;
+    _mapped = false;
+    _borrowed = false;
+    _open = false;
+    _buffer.clear();
+}
+
+bool MappedFile::isOpen() const {
+    return _open;
+}
+
+const unsigned char *MappedFile::data() const {
+    return _data;
+}
+
+size_t MappedFile::size() const {
+    return _size;
+}
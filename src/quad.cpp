@@ -1,10 +1,36 @@
+#include <cmath>
+#include <algorithm>
+
 #include <glm/glm.hpp>
 
 #include "quad.hpp"
+#include "batch.hpp"
+#include "shader_variants.hpp"
 #include "debug.hpp"
 
-/// @brief Shader used to render quads
-static Shader quadShader;
+/// @brief Quad shader features, bits of a variant key
+enum QuadFeature : uint32_t {
+    /// @brief Same circular radius on every corner
+    QUAD_ROUNDED_CIRCULAR = 1u << 0,
+
+    /// @brief Independent elliptical radius per corner
+    QUAD_ROUNDED_ELLIPTICAL = 1u << 1,
+};
+
+/// @brief Macro name of each QuadFeature bit, in bit order
+static const std::vector<std::string> QUAD_FEATURES = {
+    "ROUNDED_CIRCULAR",
+    "ROUNDED_ELLIPTICAL",
+};
+
+/// @brief Tolerance in pixels for corner radiuses to be considered equal
+static constexpr float CIRCULAR_RADIUS_EPSILON = 1e-3f;
+
+/// @brief Shader variants used to render quads, plain rectangles use the one without features
+static ShaderVariants quadShaders;
+
+/// @brief Current projection matrix, set on every variant
+static glm::mat4 projection{1.0f};
 
 /// @brief OpenGL objects for quad rendering
 static unsigned int quadVAO, quadVBO, quadEBO;
@@ -12,21 +38,32 @@ static unsigned int quadVAO, quadVBO, quadEBO;
 /// @brief Whether quad resources are already initialized
 static bool initialized = false;
 
+/// @brief Storage of every quad
+static NodePool<Quad> quadPool;
+
+/// @brief Last version given to a quad transform, 0 is reserved for the identity of roots
+static uint64_t lastTransformVersion = 0;
+
 namespace QuadModule {
 
-bool init(const std::string &rootPath, const glm::vec2 &windowSize) {
+bool init(const glm::vec2 &windowSize) {
     if (initialized) return true;
     initialized = true;
 
 
     // Initialize shader and set initial uniforms
     // ------------------------------------------
-    quadShader = Shader{
-        rootPath + "/resources/shaders/quad.vs",
-        rootPath + "/resources/shaders/quad.fs"
+    quadShaders = ShaderVariants{
+        "shaders/quad.vs",
+        "shaders/quad.fs",
+        QUAD_FEATURES,
+        [](const Shader &shader) { shader.setMat4("projection", projection); }
     };
     onWindowResize(windowSize);
 
+    // Plain rectangles are the common case, so that variant compiles along with the other modules' shaders
+    quadShaders.prepare(0);
+
     // Construct VAO for text rendering
     // --------------------------------
 
@@ -81,7 +118,7 @@ void terminate() {
     if (!initialized) return;
     initialized = false;
 
-    quadShader.destroy();
+    quadShaders.destroy();
     glDeleteBuffers(1, &quadVBO); glCheckError();
     glDeleteBuffers(1, &quadEBO); glCheckError();
     glDeleteVertexArrays(1, &quadVAO); glCheckError();
@@ -90,7 +127,7 @@ void terminate() {
 void onWindowResize(const glm::vec2 &windowSize) {
     if (!initialized) return;
 
-    quadShader.setMat4("projection", glm::ortho(
+    projection = glm::ortho(
         // left-right
         0.0f, windowSize.x,
 
@@ -99,45 +136,79 @@ void onWindowResize(const glm::vec2 &windowSize) {
 
         // near-far
         0.0f, 1.0f
-    ));
+    );
+    quadShaders.forEach([](const Shader &shader) { shader.setMat4("projection", projection); });
+}
+
+QuadHandle create() {
+    return quadPool.create();
+}
+
+void destroy(QuadHandle handle) {
+    Quad *quad = quadPool.get(handle);
+    if (quad == nullptr) return;
+
+    if (quad->_parent) quad->_parent->removeChild(handle);
+    for (QuadHandle child : quad->_children) {
+        Quad *childQuad = quadPool.get(child);
+        if (childQuad == nullptr) continue;
+
+        // Detached first, so it doesn't look itself up in the children being iterated
+        childQuad->_parent = nullptr;
+        destroy(child);
+    }
+    quadPool.destroy(handle);
 }
 
+bool isValid(QuadHandle handle) {
+    return quadPool.isValid(handle);
 }
 
-Quad::Quad(const glm::vec2 &windowSize) {
+Quad *get(QuadHandle handle) {
+    return quadPool.get(handle);
+}
+
+size_t count() {
+    return quadPool.size();
+}
+
+}
+
+Quad::Quad() {
+    _layout.setAnchorPoint(glm::vec2{0.5f});
+}
+
+Quad::Quad(const glm::vec2 &windowSize) : Quad() {
     onWindowResize(windowSize);
 }
 
 void Quad::setPosition(const Dim2 &pos) {
-    _pos = pos;
-    calculateModelMatrix();
+    _layout.setPosition(pos);
 }
 
 Dim2 Quad::position() const {
-    return _pos;
+    return _layout.position();
 }
 
 void Quad::setAnchorPoint(const glm::vec2 &anchorPoint) {
-    _anchorPoint = glm::clamp(anchorPoint, glm::vec2{0.0f}, glm::vec2{1.0f});
-    calculateModelMatrix();
+    _layout.setAnchorPoint(glm::clamp(anchorPoint, glm::vec2{0.0f}, glm::vec2{1.0f}));
 }
 
 glm::vec2 Quad::anchorPoint() const {
-    return _anchorPoint;
+    return _layout.anchorPoint();
 }
 
 void Quad::setSize(const Dim2 &size) {
-    _size = Dim2::max(Dim2::zero(), size);
-    calculateModelMatrix();
+    _layout.setSize(Dim2::max(Dim2::zero(), size));
 }
 
 Dim2 Quad::size() const {
-    return _size;
+    return _layout.size();
 }
 
 void Quad::setRotation(float rotation) {
     _rotation = rotation;
-    calculateModelMatrix();
+    _transformDirty = true;
 }
 
 float Quad::rotation() const {
@@ -160,45 +231,121 @@ BorderRadius Quad::borderRadius() const {
     return _borderRadius;
 }
 
-void Quad::addChild(const std::shared_ptr<Quad> &child) {
-    children.push_back(child);
+void Quad::addChild(QuadHandle child) {
+    Quad *quad = quadPool.get(child);
+    if (quad == nullptr || quad == this) return;
+    if (quad->_parent) quad->_parent->removeChild(child);
+
+    quad->_parent = this;
+    _children.push_back(child);
+    _layout.addChild(&quad->_layout);
+}
+
+void Quad::removeChild(QuadHandle child) {
+    auto it = std::find(_children.begin(), _children.end(), child);
+    if (it == _children.end()) return;
+    _children.erase(it);
+
+    Quad *quad = quadPool.get(child);
+    if (quad == nullptr) return;
+    quad->_parent = nullptr;
+    _layout.removeChild(&quad->_layout);
+}
+
+const std::vector<QuadHandle> &Quad::children() const {
+    return _children;
+}
+
+Quad *Quad::parent() const {
+    return _parent;
+}
+
+LayoutNode &Quad::layout() {
+    return _layout;
+}
+
+const LayoutNode &Quad::layout() const {
+    return _layout;
 }
 
 void Quad::draw(
     const glm::vec2 &windowSize,
-    const glm::mat4 &model
+    const glm::mat4 &parentTransform
 ) {
-    setUniforms(windowSize, model);
+    // A caller-provided transform can change without notice, so it's never taken as unchanged
+    const bool identity = parentTransform == glm::mat4{1.0f};
+    draw(windowSize, parentTransform, identity ? 0 : ++lastTransformVersion);
+}
 
-    // Draw elements
-    glBindVertexArray(quadVAO); glCheckError();
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0); glCheckError();
-    glBindVertexArray(0); glCheckError();
+void Quad::draw(
+    const glm::vec2 &windowSize,
+    const glm::mat4 &parentTransform,
+    uint64_t parentVersion
+) {
+    // Only subtrees that changed are laid out again
+    if (_layout.parent() == nullptr) _layout.update(windowSize);
+
+    // Transforms are only computed again when the rectangle, rotation or parent transform changed.
+    // Setters just mark them dirty, so several changes in a frame cost a single computation
+    const glm::vec2 position = _layout.computedPosition();
+    const glm::vec2 size = _layout.computedSize();
+    const glm::vec2 halfSize = size * 0.5f;
+    if (
+        _transformDirty || parentVersion != _parentVersion ||
+        position != _transformPosition || size != _transformSize
+    ) {
+        // Rotate around center, children are placed relative to the top left corner
+        glm::mat4 transform = glm::translate(parentTransform, glm::vec3(position + halfSize, 0.0f));
+        transform = glm::rotate(transform, _rotation, glm::vec3{0.0f, 0.0f, 1.0f});
+        _model = glm::scale(transform, glm::vec3(halfSize, 1.0f));
+        _transform = glm::translate(transform, glm::vec3(-halfSize, 0.0f));
+
+        _transformPosition = position;
+        _transformSize = size;
+        _parentVersion = parentVersion;
+        _transformVersion = ++lastTransformVersion;
+        _transformDirty = false;
+    }
 
-    // Draw children
-    for (auto &child : children) {
-        child->draw(windowSize, model * _modelMatrix);
+    if (BatchModule::isRecording()) {
+        // Batched quads take their radii in pixels, so any corner shape goes in the same draw call
+        glm::vec2 borderTL, borderTR, borderBL, borderBR;
+        normalizedCorners(size, borderTL, borderTR, borderBL, borderBR);
+        BatchModule::submitQuad(
+            _model,
+            _color,
+            glm::vec4{borderTL * size, borderTR * size},
+            glm::vec4{borderBL * size, borderBR * size}
+        );
+    } else {
+        setUniforms(_model, size);
+
+        // Draw elements
+        glBindVertexArray(quadVAO); glCheckError();
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0); glCheckError();
+        glBindVertexArray(0); glCheckError();
+    }
+
+    // Draw children, which only compute their transforms again if this one changed
+    for (QuadHandle child : _children) {
+        quadPool.get(child)->draw(windowSize, _transform, _transformVersion);
     }
 
     glBindVertexArray(0); glCheckError();
 }
 
-void Quad::setUniforms(
-    const glm::vec2 &windowSize,
-    const glm::mat4 &model
-) {
-    // Set attributes
-    quadShader.setVec4("color", _color);
-    quadShader.setMat4("model", model * _modelMatrix);
-
-    // Get border radius in [0-1] scale
-    glm::vec2 quadPixelsSize = _size.toPixels(windowSize);
-
+void Quad::normalizedCorners(
+    const glm::vec2 &quadPixelsSize,
+    glm::vec2 &borderTL,
+    glm::vec2 &borderTR,
+    glm::vec2 &borderBL,
+    glm::vec2 &borderBR
+) const {
     // Convert to 2D vector
-    glm::vec2 borderTL = _borderRadius.topLeft    ().toScale(quadPixelsSize);
-    glm::vec2 borderTR = _borderRadius.topRight   ().toScale(quadPixelsSize);
-    glm::vec2 borderBL = _borderRadius.bottomLeft ().toScale(quadPixelsSize);
-    glm::vec2 borderBR = _borderRadius.bottomRight().toScale(quadPixelsSize);
+    borderTL = _borderRadius.topLeft    ().toScale(quadPixelsSize);
+    borderTR = _borderRadius.topRight   ().toScale(quadPixelsSize);
+    borderBL = _borderRadius.bottomLeft ().toScale(quadPixelsSize);
+    borderBR = _borderRadius.bottomRight().toScale(quadPixelsSize);
 
     // Correct radius overlap
     {
@@ -244,54 +391,67 @@ void Quad::setUniforms(
     borderBL = glm::clamp(borderBL, glm::vec2{0.0f}, glm::vec2{1.0f});
     borderBR = glm::clamp(borderBR, glm::vec2{0.0f}, glm::vec2{1.0f});
 
-    // Cache inverses
-    bool checkTL = false;
-    bool checkTR = false;
-    bool checkBL = false;
-    bool checkBR = false;
+    // A corner is only rounded if it has radius on both axes
+    const glm::vec2 zero{0.0f};
+    if (borderTL.x * borderTL.y <= 0) borderTL = zero;
+    if (borderTR.x * borderTR.y <= 0) borderTR = zero;
+    if (borderBL.x * borderBL.y <= 0) borderBL = zero;
+    if (borderBR.x * borderBR.y <= 0) borderBR = zero;
+}
 
-    if (borderTL.x * borderTL.y > 0) {
-        checkTL = true;
-        quadShader.setVec2("inv2TL", 1.0f / glm::pow(borderTL, glm::vec2{2.0f}));
-    }
-    if (borderTR.x * borderTR.y > 0) {
-        checkTR = true;
-        quadShader.setVec2("inv2TR", 1.0f / glm::pow(borderTR, glm::vec2{2.0f}));
-    }
-    if (borderBL.x * borderBL.y > 0) {
-        checkBL = true;
-        quadShader.setVec2("inv2BL", 1.0f / glm::pow(borderBL, glm::vec2{2.0f}));
-    }
-    if (borderBR.x * borderBR.y > 0) {
-        checkBR = true;
-        quadShader.setVec2("inv2BR", 1.0f / glm::pow(borderBR, glm::vec2{2.0f}));
+void Quad::setUniforms(
+    const glm::mat4 &model,
+    const glm::vec2 &quadPixelsSize
+) {
+    glm::vec2 borderTL, borderTR, borderBL, borderBR;
+    normalizedCorners(quadPixelsSize, borderTL, borderTR, borderBL, borderBR);
+
+    // Pick cheapest variant that can draw these corners
+    uint32_t features = 0;
+    const glm::vec2 zero{0.0f};
+    const glm::vec2 halfSize = quadPixelsSize * 0.5f;
+    const glm::vec2 radiusTL = borderTL * quadPixelsSize;
+    const bool anyRounded = borderTL != zero || borderTR != zero || borderBL != zero || borderBR != zero;
+    if (anyRounded) {
+        auto sameRadius = [&](const glm::vec2 &border) {
+            const glm::vec2 radius = border * quadPixelsSize;
+            return
+                std::abs(radius.x - radiusTL.x) <= CIRCULAR_RADIUS_EPSILON &&
+                std::abs(radius.y - radiusTL.y) <= CIRCULAR_RADIUS_EPSILON;
+        };
+        const bool circular =
+            std::abs(radiusTL.x - radiusTL.y) <= CIRCULAR_RADIUS_EPSILON &&
+            sameRadius(borderTR) && sameRadius(borderBL) && sameRadius(borderBR);
+        features = circular ? QUAD_ROUNDED_CIRCULAR : QUAD_ROUNDED_ELLIPTICAL;
     }
+    const Shader &shader = quadShaders.get(features);
 
-    quadShader.setBool("checkTL", checkTL);
-    quadShader.setBool("checkTR", checkTR);
-    quadShader.setBool("checkBL", checkBL);
-    quadShader.setBool("checkBR", checkBR);
+    // Set attributes
+    shader.setVec4("color", _color);
+    shader.setMat4("model", model);
 
-    quadShader.setVec2("borderTL", borderTL);
-    quadShader.setVec2("borderTR", borderTR);
-    quadShader.setVec2("borderBL", borderBL);
-    quadShader.setVec2("borderBR", borderBR);
+    if (features & QUAD_ROUNDED_CIRCULAR) {
+        shader.setVec2("halfSize", halfSize);
+        shader.setFloat("radius", radiusTL.x);
+    }
+
+    if (features & QUAD_ROUNDED_ELLIPTICAL) {
+        // Cache inverses, square corners never pass the corner test so theirs are unused
+        auto inverse2 = [](const glm::vec2 &border) {
+            return border.x * border.y > 0 ? 1.0f / glm::pow(border, glm::vec2{2.0f}) : glm::vec2{0.0f};
+        };
+        shader.setVec2("inv2TL", inverse2(borderTL));
+        shader.setVec2("inv2TR", inverse2(borderTR));
+        shader.setVec2("inv2BL", inverse2(borderBL));
+        shader.setVec2("inv2BR", inverse2(borderBR));
+
+        shader.setVec2("borderTL", borderTL);
+        shader.setVec2("borderTR", borderTR);
+        shader.setVec2("borderBL", borderBL);
+        shader.setVec2("borderBR", borderBR);
+    }
 }
 
 void Quad::onWindowResize(const glm::vec2 &windowSize) {
-    _lastWindowSize = windowSize;
-    calculateModelMatrix();
-}
-
-void Quad::calculateModelMatrix() {
-    // Get translation based on anchor point
-    auto _scaledPos = _pos.toPixels(_lastWindowSize);
-    auto _scaledSize = _size.toPixels(_lastWindowSize) * 0.5f;
-    auto _correctedPos = _scaledPos - _scaledSize * (_anchorPoint * 2.0f - 1.0f);
-
-    // Set model matrix
-    _modelMatrix = glm::mat4{1.0f};
-    _modelMatrix = glm::translate(_modelMatrix, glm::vec3(_correctedPos, 0.0f));
-    _modelMatrix = glm::scale(_modelMatrix, glm::vec3(_scaledSize, 1.0f));
-    _modelMatrix = glm::rotate(_modelMatrix, _rotation, glm::vec3{0.0f, 0.0f, 1.0f});
-}
\ No newline at end of file
+    if (_layout.parent() == nullptr) _layout.update(windowSize);
+}
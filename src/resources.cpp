@@ -0,0 +1,66 @@
+#include <cstring>
+#include <algorithm>
+
+#include "resources.hpp"
+
+/// @brief Embedded resources sorted by name, defined by the generated embedded_resources.cpp
+extern const Resources::Embedded EMBEDDED_RESOURCES[];
+
+/// @brief Number of embedded resources
+extern const size_t EMBEDDED_RESOURCES_COUNT;
+
+/// @brief Directory searched before embedded resources, empty if not set
+static std::string _overrideDirectory;
+
+/// @brief Finds an embedded resource
+/// @param name path relative to the resources directory
+/// @return resource, null if not embedded
+static const Resources::Embedded *findEmbedded(const std::string &name) {
+    const Resources::Embedded *end = EMBEDDED_RESOURCES + EMBEDDED_RESOURCES_COUNT;
+    const Resources::Embedded *it = std::lower_bound(
+        EMBEDDED_RESOURCES, end, name,
+        [](const Resources::Embedded &resource, const std::string &name) {
+            return std::strcmp(resource.name, name.c_str()) < 0;
+        }
+    );
+    return it != end && name == it->name ? it : nullptr;
+}
+
+namespace Resources {
+
+void setOverrideDirectory(const std::string &directory) {
+    _overrideDirectory = directory;
+}
+
+std::string overrideDirectory() {
+    return _overrideDirectory;
+}
+
+std::shared_ptr<const MappedFile> open(const std::string &name) {
+    if (!_overrideDirectory.empty()) {
+        auto file = std::make_shared<MappedFile>();
+        if (file->open(_overrideDirectory + "/" + name)) return file;
+    }
+
+    const Embedded *resource = findEmbedded(name);
+    if (resource == nullptr) return nullptr;
+
+    auto file = std::make_shared<MappedFile>();
+    file->view(resource->data, resource->size);
+    return file;
+}
+
+bool isEmbedded(const std::string &name) {
+    return findEmbedded(name) != nullptr;
+}
+
+std::vector<std::string> embedded() {
+    std::vector<std::string> names;
+    names.reserve(EMBEDDED_RESOURCES_COUNT);
+    for (size_t i = 0; i < EMBEDDED_RESOURCES_COUNT; ++i) {
+        names.push_back(EMBEDDED_RESOURCES[i].name);
+    }
+    return names;
+}
+
+} // Resources
@@ -0,0 +1,55 @@
+#include <algorithm>
+
+#include "scene.hpp"
+
+Scene::Scene() {
+    _layout.setSize(Dim2::fromScale(1.0f, 1.0f));
+}
+
+void Scene::addChild(QuadHandle child) {
+    Quad *quad = QuadModule::get(child);
+    if (quad == nullptr) return;
+    if (std::find(_children.begin(), _children.end(), child) != _children.end()) return;
+
+    // Otherwise it'd be laid out and drawn by both parents
+    if (Quad *parent = quad->parent()) parent->removeChild(child);
+
+    _children.push_back(child);
+    _layout.addChild(&quad->layout());
+}
+
+void Scene::removeChild(QuadHandle child) {
+    auto it = std::find(_children.begin(), _children.end(), child);
+    if (it == _children.end()) return;
+    _children.erase(it);
+
+    if (QuadModule::isValid(child)) _layout.removeChild(&QuadModule::get(child)->layout());
+}
+
+const std::vector<QuadHandle> &Scene::children() const {
+    return _children;
+}
+
+LayoutNode &Scene::layout() {
+    return _layout;
+}
+
+void Scene::onWindowResize(const glm::vec2 &windowSize) {
+    _layout.update(windowSize);
+}
+
+void Scene::draw(const glm::vec2 &windowSize) {
+    // Only subtrees that changed are laid out again
+    _layout.update(windowSize);
+
+    // Top level quads destroyed or moved under another quad since last frame already left the layout,
+    // forget their handles
+    _children.erase(std::remove_if(_children.begin(), _children.end(), [this](QuadHandle child) {
+        Quad *quad = QuadModule::isValid(child) ? QuadModule::get(child) : nullptr;
+        return quad == nullptr || quad->layout().parent() != &_layout;
+    }), _children.end());
+
+    for (QuadHandle child : _children) {
+        QuadModule::get(child)->draw(windowSize);
+    }
+}
@@ -1,93 +1,193 @@
+#include <chrono>
+#include <unordered_map>
+
 #include "shader.hpp"
+#include "resources.hpp"
+#include "gl_extensions.hpp"
+#include "shader_cache.hpp"
 #include "debug.hpp"
 
-Shader::Shader(const std::string &vertexShaderPath, const std::string &fragmentShaderPath) {
-    // Retrieve the vertex/fragment source code from filePath
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
-
-    // Ensure ifstream objects can throw exceptions:
-    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try {
-        // Open files
-        vShaderFile.open(vertexShaderPath);
-        fShaderFile.open(fragmentShaderPath);
-
-        // Read file's buffer contents into streams
-        std::stringstream vShaderStream, fShaderStream;
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();
-
-        // Close file handlers
-        vShaderFile.close();
-        fShaderFile.close();
-
-        // Convert stream into string
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
+/// @brief Reads a shader source
+/// @param name resource name, or file path if no resource has that name
+/// @return source code
+static std::string readSource(const std::string &name) {
+    std::shared_ptr<const MappedFile> file = Resources::open(name);
+    if (!file) {
+        auto diskFile = std::make_shared<MappedFile>();
+        if (diskFile->open(name)) file = diskFile;
     }
-    catch (std::ifstream::failure &e) {
-        std::cerr << "Error in shader | File not successfully read\n" << e.what() << "\n";
+    if (!file) {
+        std::cerr << "Error in shader | Resource " << name << " not found\n";
         exit(1);
     }
-    const char *vShaderCode = vertexCode.c_str();
-    const char *fShaderCode = fragmentCode.c_str();
+    return std::string{(const char *)file->data(), file->size()};
+}
 
-    // Compile shaders
-    unsigned int vertex, fragment;
-    int success;
-    char infoLog[513];
+/// @brief Defines macros in a shader source
+/// @param code shader source, modified in place
+/// @param defines macro names, inserted after the #version line (which must stay first)
+static void injectDefines(std::string &code, const std::vector<std::string> &defines) {
+    if (defines.empty()) return;
 
-    // Vertex Shader
-    vertex = glCreateShader(GL_VERTEX_SHADER); glCheckError();
-    glShaderSource(vertex, 1, &vShaderCode, NULL); glCheckError();
-    glCompileShader(vertex); glCheckError();
+    std::string block;
+    for (const auto &define : defines) {
+        block += "#define " + define + "\n";
+    }
 
-    // Print compile errors if any
-    glGetShaderiv(vertex, GL_COMPILE_STATUS, &success); glCheckError();
-    if (!success) {
-        glGetShaderInfoLog(vertex, 512, NULL, infoLog); glCheckError();
-        debugPrint("Error in shader | Vertex shader compilation failed\n%s\n", infoLog);
-    };
+    size_t pos = 0;
+    if (code.compare(0, 8, "#version") == 0) {
+        pos = code.find('\n');
+        pos = pos == std::string::npos ? code.size() : pos + 1;
+        if (pos == code.size() && code.back() != '\n') block.insert(0, "\n");
+    }
+    code.insert(pos, block);
+}
 
-    // Similiar for Fragment Shader
-    fragment = glCreateShader(GL_FRAGMENT_SHADER); glCheckError();
-    glShaderSource(fragment, 1, &fShaderCode, NULL); glCheckError();
-    glCompileShader(fragment); glCheckError();
+/// @brief Program whose compile and link were submitted but not checked yet
+struct PendingProgram {
+    /// @brief Vertex shader ID
+    unsigned int vertex;
+
+    /// @brief Fragment shader ID
+    unsigned int fragment;
+
+    /// @brief Program binary cache key
+    uint64_t key;
+
+    /// @brief Shader file paths and defines, for messages
+    std::string name;
+
+    /// @brief When sources started being read
+    std::chrono::steady_clock::time_point start;
+};
+
+/// @brief Pending programs by ID
+static std::unordered_map<unsigned int, PendingProgram> pendingPrograms;
+
+/// @brief Submits a shader stage for compilation, without waiting for it
+/// @param type GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+/// @param code shader source
+/// @return shader ID
+static unsigned int submitStage(GLenum type, const std::string &code) {
+    const char *source = code.c_str();
+    unsigned int shader = glCreateShader(type); glCheckError();
+    glShaderSource(shader, 1, &source, NULL); glCheckError();
+    glCompileShader(shader); glCheckError();
+    return shader;
+}
 
-    // Print compile errors if any
-    glGetShaderiv(fragment, GL_COMPILE_STATUS, &success); glCheckError();
+/// @brief Prints compile errors of a shader stage if any
+/// @param shader shader ID
+/// @param type GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+static void checkStage(unsigned int shader, GLenum type) {
+    int success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success); glCheckError();
     if (!success) {
-        glGetShaderInfoLog(fragment, 512, NULL, infoLog); glCheckError();
-        debugPrint("Error in shader | Fragment shader compilation failed\n%s\n", infoLog);
-    };
+        char infoLog[513];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog); glCheckError();
+        debugPrint("Error in shader | %s shader compilation failed\n%s\n", type == GL_VERTEX_SHADER ? "Vertex" : "Fragment", infoLog);
+    }
+}
 
-    // Shader Program
-    id = glCreateProgram(); glCheckError();
-    glAttachShader(id, vertex); glCheckError();
-    glAttachShader(id, fragment); glCheckError();
-    glLinkProgram(id); glCheckError();
+/// @brief Waits for a pending program, checking its status and storing its binary
+/// @param id program ID, ignored if not pending
+static void finishProgram(unsigned int id) {
+    auto it = pendingPrograms.find(id);
+    if (it == pendingPrograms.end()) return;
+    const PendingProgram pending = std::move(it->second);
+    pendingPrograms.erase(it);
 
-    // Print linking errors if any
+    // Print errors if any, only link status is needed if it succeeded
+    int success;
     glGetProgramiv(id, GL_LINK_STATUS, &success); glCheckError();
     if (!success) {
+        checkStage(pending.vertex, GL_VERTEX_SHADER);
+        checkStage(pending.fragment, GL_FRAGMENT_SHADER);
+
+        char infoLog[513];
         glGetProgramInfoLog(id, 512, NULL, infoLog); glCheckError();
         debugPrint("Error in shader | Program linking failed\n%s\n", infoLog);
     }
+    else {
+        ShaderCache::store(pending.key, id);
+    }
 
     // Delete the shaders as they're linked into our program now and no longer necessary
-    glDeleteShader(vertex); glCheckError();
-    glDeleteShader(fragment); glCheckError();
+    glDeleteShader(pending.vertex); glCheckError();
+    glDeleteShader(pending.fragment); glCheckError();
+
+    const float time = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - pending.start).count();
+    debugPrint("Shader %s compiled, %.2fms after submission\n", pending.name.c_str(), time);
+}
+
+Shader::Shader(const std::string &vertexShaderPath, const std::string &fragmentShaderPath, const std::vector<std::string> &defines) {
+    const auto start = std::chrono::steady_clock::now();
+
+    // Retrieve the vertex/fragment source code from filePath
+    std::string vertexCode = readSource(vertexShaderPath);
+    std::string fragmentCode = readSource(fragmentShaderPath);
+    injectDefines(vertexCode, defines);
+    injectDefines(fragmentCode, defines);
+
+    std::string name = vertexShaderPath + " + " + fragmentShaderPath;
+    for (size_t i = 0; i < defines.size(); ++i) {
+        name += (i == 0 ? " | " : " ") + defines[i];
+    }
+
+    // Reuse binary of a previous run if the driver still accepts it
+    const uint64_t key = ShaderCache::key(vertexCode, fragmentCode);
+    id = ShaderCache::load(key);
+    _fromCache = id != 0;
+    if (_fromCache) {
+        const float time = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        debugPrint("Shader %s loaded from cache in %.2fms\n", name.c_str(), time);
+        return;
+    }
+
+    // Compile and link without querying status, so the driver can work on every shader at once
+    unsigned int vertex = submitStage(GL_VERTEX_SHADER, vertexCode);
+    unsigned int fragment = submitStage(GL_FRAGMENT_SHADER, fragmentCode);
+
+    id = glCreateProgram(); glCheckError();
+    ShaderCache::prepare(id);
+    glAttachShader(id, vertex); glCheckError();
+    glAttachShader(id, fragment); glCheckError();
+    glLinkProgram(id); glCheckError();
+
+    pendingPrograms[id] = PendingProgram{vertex, fragment, key, std::move(name), start};
+}
+
+bool Shader::isReady() const {
+    if (pendingPrograms.find(id) == pendingPrograms.end()) return true;
+    if (!GLExtensions::hasParallelShaderCompile()) return true;
+
+    int completed = GL_FALSE;
+    glGetProgramiv(id, GL_COMPLETION_STATUS_KHR, &completed); glCheckError();
+    return completed == GL_TRUE;
+}
+
+void Shader::finish() const {
+    finishProgram(id);
+}
+
+void Shader::finishAll() {
+    while (!pendingPrograms.empty()) {
+        finishProgram(pendingPrograms.begin()->first);
+    }
 }
 
 void Shader::use() const {
+    if (!pendingPrograms.empty()) finishProgram(id);
     glUseProgram(id); glCheckError();
 }
 
 void Shader::destroy() const {
+    auto it = pendingPrograms.find(id);
+    if (it != pendingPrograms.end()) {
+        glDeleteShader(it->second.vertex); glCheckError();
+        glDeleteShader(it->second.fragment); glCheckError();
+        pendingPrograms.erase(it);
+    }
     glDeleteProgram(id); glCheckError();
 }
 
@@ -125,3 +225,7 @@ void Shader::setMat4(const std::string &name, const glm::mat4 &mat) const {
     use();
     glUniformMatrix4fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat)); glCheckError();
 }
+
+bool Shader::fromCache() const {
+    return _fromCache;
+}
@@ -0,0 +1,199 @@
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <cstring>
+#include <system_error>
+#include <filesystem>
+
+#include "debug.hpp"
+#include "gl_extensions.hpp"
+#include "mapped_file.hpp"
+#include "shader_cache.hpp"
+
+/// @brief Magic bytes at the start of program binary files
+static const char PROGRAM_BINARY_MAGIC[8] = {'O', 'G', 'L', 'U', 'I', 'P', 'R', 'G'};
+
+/// @brief Program binary file header, followed by the binary itself
+struct ProgramBinaryHeader {
+    /// @brief Identifies file type, always "OGLUIPRG"
+    char magic[8];
+
+    /// @brief Driver-specific binary format
+    uint32_t format;
+
+    /// @brief Binary size in bytes
+    uint32_t length;
+};
+
+/// @brief Cache directory, empty if disabled
+static std::string _directory;
+
+/// @brief Driver vendor, renderer and version strings, read on first key
+static std::string driverInfo;
+
+/// @brief Lookup counters
+static size_t _hits = 0, _misses = 0;
+
+/// @brief Hashes bytes into a running 64-bit FNV-1a hash
+/// @param hash running hash
+/// @param data bytes to hash
+/// @param size number of bytes (a zero byte is hashed after them, so fields don't run together)
+static void hashBytes(uint64_t &hash, const char *data, size_t size) {
+    for (size_t i = 0; i <= size; ++i) {
+        hash ^= i < size ? (unsigned char)data[i] : 0;
+        hash *= 1099511628211ull;
+    }
+}
+
+/// @brief Gets path of the binary file of a program
+/// @param key program key
+/// @return file path
+static std::string pathFor(uint64_t key) {
+    std::stringstream sstr;
+    sstr << _directory << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".glbin";
+    return sstr.str();
+}
+
+namespace ShaderCache {
+
+void setDirectory(const std::string &directory) {
+    _directory = directory;
+    if (_directory.empty()) return;
+
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    if (error) {
+        debugPrint("Failed to create shader cache directory %s, cache disabled\n", _directory.c_str());
+        _directory.clear();
+    }
+}
+
+std::string directory() {
+    return _directory;
+}
+
+bool enabled() {
+    return !_directory.empty() && GLExtensions::hasProgramBinary();
+}
+
+uint64_t key(const std::string &vertexCode, const std::string &fragmentCode) {
+    if (driverInfo.empty()) {
+        for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+            const char *value = (const char *)glGetString(name); glCheckError();
+            driverInfo += value != nullptr ? value : "";
+            driverInfo += '\n';
+        }
+    }
+
+    uint64_t hash = 14695981039346656037ull;
+    hashBytes(hash, vertexCode.data(), vertexCode.size());
+    hashBytes(hash, fragmentCode.data(), fragmentCode.size());
+    hashBytes(hash, driverInfo.data(), driverInfo.size());
+    return hash;
+}
+
+unsigned int load(uint64_t key) {
+    if (!enabled()) {
+        ++_misses;
+        return 0;
+    }
+
+    const std::string path = pathFor(key);
+    MappedFile file;
+    if (!file.open(path)) {
+        ++_misses;
+        return 0;
+    }
+
+    // Check file is complete
+    ProgramBinaryHeader header;
+    bool valid = file.size() >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, file.data(), sizeof(header));
+        valid =
+            std::memcmp(header.magic, PROGRAM_BINARY_MAGIC, sizeof(PROGRAM_BINARY_MAGIC)) == 0 &&
+            sizeof(header) + (uint64_t)header.length <= file.size();
+    }
+
+    unsigned int program = 0;
+    if (valid) {
+        // Errors left by earlier calls are reported first, so they aren't taken for a rejection below
+        program = glCreateProgram(); glCheckError();
+        GLExtensions::programBinary(program, header.format, file.data() + sizeof(header), header.length);
+
+        // Drivers reject binaries after updates or from other GPUs, which isn't an error (link status tells)
+        glGetError();
+        int success;
+        glGetProgramiv(program, GL_LINK_STATUS, &success); glCheckError();
+        if (!success) {
+            glDeleteProgram(program); glCheckError();
+            program = 0;
+        }
+    }
+
+    file.close();
+    if (program == 0) {
+        debugPrint("Program binary %s rejected, recompiling\n", path.c_str());
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        ++_misses;
+        return 0;
+    }
+
+    ++_hits;
+    return program;
+}
+
+void prepare(unsigned int program) {
+    if (!enabled()) return;
+    GLExtensions::programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE); glCheckError();
+}
+
+void store(uint64_t key, unsigned int program) {
+    if (!enabled()) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length); glCheckError();
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    ProgramBinaryHeader header;
+    std::memcpy(header.magic, PROGRAM_BINARY_MAGIC, sizeof(PROGRAM_BINARY_MAGIC));
+    GLsizei written = 0;
+    GLenum format = 0;
+    GLExtensions::getProgramBinary(program, length, &written, &format, binary.data()); glCheckError();
+    if (written <= 0) return;
+    header.format = format;
+    header.length = written;
+
+    // Written to a temporary file first, so a crash never leaves a truncated binary behind
+    const std::string path = pathFor(key);
+    const std::string tempPath = path + ".tmp";
+    bool stored;
+    {
+        std::ofstream file{tempPath, std::ios::binary | std::ios::trunc};
+        file.write((const char *)&header, sizeof(header));
+        file.write(binary.data(), written);
+        file.close();
+        stored = (bool)file;
+    }
+
+    // Temporary file is removed on any failure
+    std::error_code error;
+    if (stored) std::filesystem::rename(tempPath, path, error);
+    if (!stored || error) {
+        debugPrint("Failed to store program binary %s\n", path.c_str());
+        std::filesystem::remove(tempPath, error);
+    }
+}
+
+size_t hits() {
+    return _hits;
+}
+
+size_t misses() {
+    return _misses;
+}
+
+} // ShaderCache
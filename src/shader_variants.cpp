@@ -0,0 +1,61 @@
+#include "shader_variants.hpp"
+#include "debug.hpp"
+
+ShaderVariants::ShaderVariants(
+    const std::string &vertexPath,
+    const std::string &fragmentPath,
+    const std::vector<std::string> &features,
+    const std::function<void(const Shader &)> &setup
+) :
+    _vertexPath{vertexPath},
+    _fragmentPath{fragmentPath},
+    _features{features},
+    _setup{setup}
+{
+    if (_features.size() > 32) {
+        debugPrint("Shader %s has %zu features, only the first 32 can be selected\n", _fragmentPath.c_str(), _features.size());
+        _features.resize(32);
+    }
+}
+
+void ShaderVariants::prepare(uint32_t key) {
+    if (_variants.count(key) != 0) return;
+
+    std::vector<std::string> defines;
+    for (size_t i = 0; i < _features.size(); ++i) {
+        if (key & (1u << i)) defines.push_back(_features[i]);
+    }
+    _variants.emplace(key, Variant{Shader{_vertexPath, _fragmentPath, defines}});
+}
+
+const Shader &ShaderVariants::get(uint32_t key) {
+    auto it = _variants.find(key);
+    if (it == _variants.end()) {
+        prepare(key);
+        it = _variants.find(key);
+    }
+
+    Variant &variant = it->second;
+    if (!variant.setUp) {
+        variant.setUp = true;
+        if (_setup) _setup(variant.shader);
+    }
+    return variant.shader;
+}
+
+void ShaderVariants::forEach(const std::function<void(const Shader &)> &function) const {
+    for (const auto &[key, variant] : _variants) {
+        if (variant.setUp) function(variant.shader);
+    }
+}
+
+size_t ShaderVariants::size() const {
+    return _variants.size();
+}
+
+void ShaderVariants::destroy() {
+    for (const auto &[key, variant] : _variants) {
+        variant.shader.destroy();
+    }
+    _variants.clear();
+}
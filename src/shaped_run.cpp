@@ -0,0 +1,156 @@
+#include <list>
+#include <unordered_map>
+#include <functional>
+
+#include "shaped_run.hpp"
+
+size_t ShapedRun::memoryUsage() const {
+    return sizeof(ShapedRun) +
+        lines.capacity() * sizeof(ShapedLine) +
+        glyphs.capacity() * sizeof(PlacedGlyph);
+}
+
+bool ShapedRunKey::operator== (const ShapedRunKey &other) const {
+    return textHash == other.textHash &&
+        textSize == other.textSize &&
+        fontId == other.fontId &&
+        fontSize == other.fontSize &&
+        renderWidth == other.renderWidth &&
+        alignment == other.alignment &&
+        lineHeight == other.lineHeight;
+}
+
+size_t ShapedRunKeyHash::operator() (const ShapedRunKey &key) const {
+    size_t hash = std::hash<uint64_t>{}(key.textHash);
+    auto combine = [&hash](size_t value) {
+        hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    };
+    combine(std::hash<size_t>{}(key.textSize));
+    combine(std::hash<uint64_t>{}(key.fontId));
+    combine(std::hash<float>{}(key.fontSize));
+    combine(std::hash<float>{}(key.renderWidth));
+    combine(std::hash<uint32_t>{}(key.alignment));
+    combine(std::hash<float>{}(key.lineHeight));
+    return hash;
+}
+
+/// @brief Cached run
+struct CacheEntry {
+    /// @brief Layout inputs
+    ShapedRunKey key;
+
+    /// @brief Snapshot of the laid out text, compared on hits since the key only holds its hash
+    TextBuffer text;
+
+    /// @brief Shared run
+    std::shared_ptr<const ShapedRun> run;
+
+    /// @brief Memory held by run, in bytes
+    size_t memory;
+};
+
+/// @brief Cached runs, most recently used first
+static std::list<CacheEntry> entries;
+
+/// @brief Cached runs by key
+static std::unordered_map<ShapedRunKey, std::list<CacheEntry>::iterator, ShapedRunKeyHash> entriesByKey;
+
+/// @brief Memory cap in bytes
+static size_t _maxMemory = DEFAULT_SHAPED_RUN_CACHE_SIZE;
+
+/// @brief Memory held by cached runs in bytes
+static size_t _memoryUsage = 0;
+
+/// @brief Lookup counters
+static size_t _hits = 0, _misses = 0;
+
+/// @brief Drops least recently used runs until cache fits memory cap
+static void evict() {
+    while (_memoryUsage > _maxMemory && !entries.empty()) {
+        const CacheEntry &entry = entries.back();
+        _memoryUsage -= entry.memory;
+        entriesByKey.erase(entry.key);
+        entries.pop_back();
+    }
+}
+
+namespace ShapedRunCache {
+
+std::shared_ptr<const ShapedRun> find(const ShapedRunKey &key, const TextBuffer &text) {
+    auto it = entriesByKey.find(key);
+    if (it == entriesByKey.end() || it->second->text != text) {
+        ++_misses;
+        return nullptr;
+    }
+
+    ++_hits;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->run;
+}
+
+std::shared_ptr<const ShapedRun> insert(const ShapedRunKey &key, const TextBuffer &text, ShapedRun &&run) {
+    auto it = entriesByKey.find(key);
+    if (it != entriesByKey.end()) {
+        if (it->second->text == text) {
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->run;
+        }
+
+        // Hash collision, the newer text takes the slot
+        _memoryUsage -= it->second->memory;
+        entries.erase(it->second);
+        entriesByKey.erase(it);
+    }
+
+    run.lines.shrink_to_fit();
+    run.glyphs.shrink_to_fit();
+    auto shared = std::make_shared<const ShapedRun>(std::move(run));
+    const size_t memory = shared->memoryUsage();
+
+    // Runs that could never fit are handed out without being cached
+    if (memory > _maxMemory) return shared;
+
+    entries.push_front(CacheEntry{key, text.snapshot(), shared, memory});
+    entriesByKey.emplace(key, entries.begin());
+    _memoryUsage += memory;
+    evict();
+    return shared;
+}
+
+void setMaxMemory(size_t maxMemory) {
+    _maxMemory = maxMemory;
+    evict();
+}
+
+size_t maxMemory() {
+    return _maxMemory;
+}
+
+size_t memoryUsage() {
+    return _memoryUsage;
+}
+
+size_t size() {
+    return entries.size();
+}
+
+size_t hits() {
+    return _hits;
+}
+
+size_t misses() {
+    return _misses;
+}
+
+void resetStats() {
+    _hits = 0;
+    _misses = 0;
+}
+
+void clear() {
+    entriesByKey.clear();
+    entries.clear();
+    _memoryUsage = 0;
+}
+
+} // ShapedRunCache
@@ -0,0 +1,80 @@
+#include "debug.hpp"
+#include "task_pool.hpp"
+
+TaskPool::TaskPool(unsigned int numThreads) {
+    if (numThreads == 0) numThreads = 1;
+    for (unsigned int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back(&TaskPool::work, this);
+    }
+    debugPrint("Task pool started with %u threads\n", numThreads);
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stop = true;
+    }
+    _startCondition.notify_all();
+
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+}
+
+void TaskPool::parallelFor(size_t count, const std::function<void(size_t)> &task) {
+    if (count == 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _task = &task;
+        _count = count;
+        _next = 0;
+        _numDone = 0;
+        _error = nullptr;
+        ++_generation;
+    }
+    _startCondition.notify_all();
+
+    runTasks(task, count);
+
+    // Every worker must see the loop, otherwise a late one could pick up indices of the next one
+    std::unique_lock<std::mutex> lock{_mutex};
+    _doneCondition.wait(lock, [this]() { return _numDone == _threads.size(); });
+    _task = nullptr;
+
+    if (_error) std::rethrow_exception(_error);
+}
+
+unsigned int TaskPool::numThreads() const {
+    return _threads.size();
+}
+
+void TaskPool::work() {
+    uint64_t generation = 0;
+    std::unique_lock<std::mutex> lock{_mutex};
+    while (true) {
+        _startCondition.wait(lock, [this, generation]() { return _stop || _generation != generation; });
+        if (_stop) return;
+
+        generation = _generation;
+        const std::function<void(size_t)> &task = *_task;
+        const size_t count = _count;
+
+        lock.unlock();
+        runTasks(task, count);
+        lock.lock();
+
+        if (++_numDone == _threads.size()) _doneCondition.notify_one();
+    }
+}
+
+void TaskPool::runTasks(const std::function<void(size_t)> &task, size_t count) {
+    for (size_t i = _next.fetch_add(1, std::memory_order_relaxed); i < count; i = _next.fetch_add(1, std::memory_order_relaxed)) {
+        try {
+            task(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock{_mutex};
+            if (!_error) _error = std::current_exception();
+        }
+    }
+}
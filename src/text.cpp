@@ -1,35 +1,62 @@
 #include <vector>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
 
 #include <glm/glm.hpp>
 
 #include "glad/glad.h"
 
+#include "batch.hpp"
 #include "debug.hpp"
 #include "shader.hpp"
+#include "task_pool.hpp"
 #include "text.hpp"
 
 /// @brief Shader used to render text
 static Shader textShader;
 
+/// @brief Shader used to render text with signed distance field glyphs
+static Shader sdfTextShader;
+
+/// @brief Shader selected by last beginGlyphs call
+static const Shader *glyphShader = &textShader;
+
+/// @brief Glyph state set by last beginGlyphs call, submitted along with every glyph while batching
+static glm::vec4 glyphColor;
+static GlyphRenderMode glyphRenderMode = GlyphRenderMode::bitmap;
+static float glyphOutlineWidth = 0.0f;
+static glm::vec4 glyphOutlineColor;
+
 /// @brief OpenGL objects for text rendering
 static unsigned int textVAO, textVBO, textEBO;
 
 /// @brief Whether text resources are already initialized
 static bool initialized = false;
 
+/// @brief Number of layout threads
+static unsigned int _layoutThreads = 0;
+
+/// @brief Threads laying out text batches, created on first batch, null if disabled
+static std::unique_ptr<TaskPool> layoutPool;
+
 namespace TextModule {
 
-bool init(const std::string &rootPath, const glm::vec2 &windowSize) {
+bool init() {
     if (initialized) return true;
     initialized = true;
 
-    // Initialize shader and set initial uniforms
-    // ------------------------------------------
+    // Initialize shaders
+    // ------------------
+    // Projection is set by beginGlyphs, so shaders aren't waited on before their first draw
     textShader = Shader{
-        rootPath + "/resources/shaders/text.vs",
-        rootPath + "/resources/shaders/text.fs"
+        "shaders/text.vs",
+        "shaders/text.fs"
+    };
+    sdfTextShader = Shader{
+        "shaders/text.vs",
+        "shaders/text_sdf.fs"
     };
-    onWindowResize(windowSize);
 
     // Construct VAO for text rendering
     // --------------------------------
@@ -85,7 +112,9 @@ void terminate() {
     if (!initialized) return;
     initialized = false;
 
+    layoutPool.reset();
     textShader.destroy();
+    sdfTextShader.destroy();
     glDeleteBuffers(1, &textVBO); glCheckError();
     glDeleteBuffers(1, &textEBO); glCheckError();
     glDeleteVertexArrays(1, &textVAO); glCheckError();
@@ -94,7 +123,7 @@ void terminate() {
 void onWindowResize(const glm::vec2 &windowSize) {
     if (!initialized) return;
 
-    textShader.setMat4("projection", glm::ortho(
+    auto projection = glm::ortho(
         // left-right
         0.0f, windowSize.x,
 
@@ -103,223 +132,239 @@ void onWindowResize(const glm::vec2 &windowSize) {
 
         // near-far
         0.0f, 1.0f
-    ));
-}
-
+    );
+    textShader.setMat4("projection", projection);
+    sdfTextShader.setMat4("projection", projection);
 }
 
-Text::Text(const std::string &text, const Font &font) : _text{text}, _font{font} {}
-
-void Text::draw(const glm::vec2 &windowSize) {
-    if (_text == "") return;
+void beginGlyphs(
+    const glm::vec2 &windowSize,
+    const glm::vec4 &color,
+    GlyphRenderMode renderMode,
+    float outlineWidth,
+    const glm::vec4 &outlineColor
+) {
+    // Upload glyphs finished by background rasterizer since last draw
+    FontModule::uploadRasterizedGlyphs();
+
+    // Outline width is converted from font pixels to distance field units, which can't go past the spread
+    glyphColor = color;
+    glyphRenderMode = renderMode;
+    glyphOutlineWidth = std::clamp(outlineWidth / (2.0f * SDF_SPREAD), 0.0f, 0.5f);
+    glyphOutlineColor = outlineColor;
+
+    // Batched glyphs carry their own state
+    if (BatchModule::isRecording()) return;
 
     // Get projection
     auto projection = glm::ortho(0.0f, windowSize.x, windowSize.y, 0.0f, 0.0f, 1.0f);
-    glm::mat4 model{1.0f};
 
     // Set base uniforms
-    textShader.setMat4("projection", projection);
-    textShader.setVec4("color", _color);
-    textShader.setInt("tex", 0);
+    glyphShader = renderMode == GlyphRenderMode::sdf ? &sdfTextShader : &textShader;
+    glyphShader->setMat4("projection", projection);
+    glyphShader->setVec4("color", color);
+    glyphShader->setInt("tex", 0);
+
+    if (renderMode == GlyphRenderMode::sdf) {
+        glyphShader->setFloat("outlineWidth", glyphOutlineWidth);
+        glyphShader->setVec4("outlineColor", outlineColor);
+    }
 
     // Base GL bindings
     glActiveTexture(GL_TEXTURE0);
     glBindVertexArray(textVAO); glCheckError();
+}
 
-    // Calculate font scale based on given font size and font loaded height
-    float scale = _fontSize / _font.fontHeight();
-
-    // Calculate lines data to adjust to current alignment
-    auto linesData = getLinesData();
-    const float numLines = linesData.size();
-
-    // Keep track of current render position
-    const float fontOffsetY = _font.maxCharHeight() - _font.maxCharUnderflow();
-    float x = _topLeft.x;
-    float y = _topLeft.y;
-    size_t currentLine = 0;
-    float wordSpacing = 0.0f;
-
-    // Check for alignment
-    switch (_alignment) {
-    case TextAlignment::left:
-        // Left is the default, don't change anything
-        break;
-    case TextAlignment::right:
-        // Put line spacing at the start
-        x += linesData[currentLine].spacing;
-        break;
-    case TextAlignment::center:
-        // Put half the line spacing at the start
-        x += linesData[currentLine].spacing * 0.5f;
-        break;
-    case TextAlignment::justified:
-        // No spacing is put at the start, only between words/chars
-        wordSpacing = linesData[currentLine].spacing / (float)(linesData[currentLine].numWords - 1);
-        break;
+void drawGlyph(const Character &character, const glm::vec2 &baseline, float scale) {
+    // Glyph still being rasterized in background, skip it for now
+    if (character.textureID == 0) return;
+
+    // Calculate offset
+    float xpos = baseline.x + character.bearing.x * scale;
+    float ypos = baseline.y - character.bearing.y * scale;
+
+    if (BatchModule::isRecording()) {
+        BatchModule::submitGlyph(
+            character.textureID,
+            glm::vec2{xpos, ypos},
+            character.size * scale,
+            character.uvRect,
+            glyphColor,
+            glyphRenderMode,
+            glyphOutlineWidth,
+            glyphOutlineColor
+        );
+        return;
     }
 
-    const size_t textSize = _text.size();
-    for (size_t i = 0; i < textSize; ++i) {
-        char c = _text[i];
-        auto charData = _font.getCharInfo(c);
-
-        // Skip space char
-        if (c == ' ' && linesData[currentLine].endIdx != i) {
-            x += charData.advance * scale;
-            if (currentLine != numLines - 1) {
-                x += wordSpacing;
-            }
-            continue;
-        }
+    // Bind atlas page and select glyph rectangle
+    glBindTexture(GL_TEXTURE_2D, character.textureID);
+    glyphShader->setVec4("uvRect", character.uvRect);
 
-        // Check if need to go to next line
-        if (linesData[currentLine].endIdx == i) {
-            // Reset position and go to next line
-            y += _fontSize * _lineHeight;
-            x = _topLeft.x;
-            ++currentLine;
-            wordSpacing = 0.0f;
-
-            // Check for alignment on next line
-            switch (_alignment) {
-            case TextAlignment::left:
-                // Left is the default, don't change anything
-                break;
-            case TextAlignment::right:
-                // Put line spacing at the start
-                x += linesData[currentLine].spacing;
-                break;
-            case TextAlignment::center:
-                // Put half the line spacing at the start
-                x += linesData[currentLine].spacing * 0.5f;
-                break;
-            case TextAlignment::justified:
-                // No spacing is put at the start, only between words/chars
-                wordSpacing = linesData[currentLine].spacing / (float)(linesData[currentLine].numWords - 1);
-                break;
-            }
-        }
-        
-        // Bind texture
-        glBindTexture(GL_TEXTURE_2D, charData.textureID);
+    // Calculate new model matrix
+    glm::mat4 model{1.0f};
+    model = glm::translate(model, glm::vec3{xpos, ypos, 0.0f});
+    model = glm::scale(model, glm::vec3{character.size * scale, 1.0f});
 
-        // Calculate offset
-        float xpos = x + charData.bearing.x * scale;
-        float ypos = y + (fontOffsetY - charData.bearing.y) * scale;
+    glyphShader->setMat4("model", model);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0); glCheckError();
+}
 
-        // Calculate new model matrix
-        model = glm::mat4{1.0f};
-        model = glm::translate(model, glm::vec3{xpos, ypos, 0.0f});
-        model = glm::scale(model, glm::vec3{charData.size * scale, 1.0f});
+void endGlyphs() {
+    if (BatchModule::isRecording()) return;
+    glBindVertexArray(0); glCheckError();
+}
 
-        // Change render position
-        x += charData.advance * scale;
+void setLayoutThreads(unsigned int numThreads) {
+    if (numThreads == _layoutThreads) return;
+    _layoutThreads = numThreads;
+    layoutPool.reset();
+}
 
-        textShader.setMat4("model", model);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0); glCheckError();
-    }
+unsigned int layoutThreads() {
+    return _layoutThreads;
+}
 
-    // Unbind text VAO
-    glBindVertexArray(0); glCheckError();
 }
 
-std::vector<Text::Line> Text::getLinesData() {
-    std::vector<Line> linesData;
+Text::Text(const std::string &text, const Font &font) : _text{text}, _font{font} {}
+
+Text::Text(const TextBuffer &text, const Font &font) : _text{text}, _font{font} {}
+
+void Text::draw(const glm::vec2 &windowSize) {
+    if (_text.empty()) return;
 
+    // Calculate font scale based on given font size and font loaded height
     float scale = _fontSize / _font.fontHeight();
-    bool startOfWord = true;
-    size_t lastStart = 0;
-    size_t numWords = 0;
-
-    // Keep track of current position
-    float x = _topLeft.x;
-    float y = _topLeft.y;
-
-    // Traverse text
-    const size_t textSize = _text.size();
-    for (size_t i = 0; i < textSize; ++i) {
-        char c = _text[i];
-        auto charData = _font.getCharInfo(c);
-
-        // Skip space char
-        if (c == ' ') {
-            x += charData.advance * scale;
-            startOfWord = true;
-            ++numWords;
-            continue;
-        }
 
-        // Check if next word overflows width
-        if (startOfWord && i != 0) {
-            // Find next space
-            size_t idx = _text.find(' ', i);
-
-            // If not found, use end of string
-            if (idx == -1UL) {
-                idx = textSize;
-            }
-            auto word = _text.substr(i, idx - i);
-
-            // Found next space, check if word is too large
-            float textWidth = _font.calculateTextWidth(word, _fontSize);
-            if (-_topLeft.x + x + textWidth > _renderWidth) {
-                // Check if last element was a space
-                if (_text[i - 1] == ' ') {
-                    x -= _font.getCharInfo(' ').advance * scale;
-                }
-
-                // Add new line data entry to vector
-                linesData.emplace_back(lastStart, i, _renderWidth - x + _topLeft.x, numWords);
-
-                // Reset position data
-                numWords = 0;
-                lastStart = i;
-                x = _topLeft.x;
-                y += _fontSize * _lineHeight;
-            }
-        } else if (i != 0 && -_topLeft.x + x + charData.advance * scale > _renderWidth) {
-            // If not start of word, only skip line if current character overflows width
-
-            // Check if last element was a space
-            if (_text[i - 1] == ' ') {
-                x -= _font.getCharInfo(' ').advance * scale;
-            }
-
-            // Add new line data entry to vector
-            linesData.emplace_back(lastStart, i, _renderWidth - x + _topLeft.x, numWords);
-
-            // Reset position data
-            numWords = 0;
-            lastStart = i;
-            x = _topLeft.x;
-            y += _fontSize * _lineHeight;
+    if (!_run) shape();
+
+    // Rendering only offsets the finished layout
+    TextModule::beginGlyphs(windowSize, _color, _font.renderMode(), _outlineWidth / scale, _outlineColor);
+    for (const PlacedGlyph &glyph : _run->glyphs) {
+        TextModule::drawGlyph(_font.getGlyph(glyph.codepoint), _topLeft + glyph.baseline, scale);
+    }
+    TextModule::endGlyphs();
+}
+
+void Text::shape() {
+    // Texts with the same inputs share a single layout
+    const ShapedRunKey key = layoutKey();
+    _run = ShapedRunCache::find(key, _text);
+    if (_run) return;
+
+    _run = ShapedRunCache::insert(key, _text, computeLayout(*_font.metrics()));
+}
+
+ShapedRunKey Text::layoutKey() const {
+    return ShapedRunKey{
+        _text.hash(),
+        _text.size(),
+        _font.id(),
+        _fontSize,
+        _renderWidth,
+        (uint32_t)_alignment,
+        _lineHeight
+    };
+}
+
+ShapedRun Text::computeLayout(const FontMetrics &metrics) const {
+    TextLayout layout{metrics, _fontSize, _renderWidth, _lineHeight, _alignment};
+    return layout.layout(_text);
+}
+
+void Text::layoutBatch(Text *const *texts, size_t count) {
+    /// @brief Text layout to be computed
+    struct Job {
+        /// @brief Layout inputs
+        ShapedRunKey key;
+
+        /// @brief First text with these inputs
+        const Text *text;
+
+        /// @brief Metrics of text font, kept alive while workers use them
+        std::shared_ptr<const FontMetrics> metrics;
+
+        /// @brief Computed layout
+        ShapedRun run;
+    };
+    std::vector<Job> jobs;
+    std::unordered_map<ShapedRunKey, size_t, ShapedRunKeyHash> jobByKey;
+    std::vector<std::pair<Text *, size_t>> pending;
+
+    // Cache lookups (hashing also builds piece lists, so workers only read text buffers)
+    for (size_t i = 0; i < count; ++i) {
+        Text *text = texts[i];
+        if (!text->isLayoutDirty()) continue;
+
+        const ShapedRunKey key = text->layoutKey();
+        text->_run = ShapedRunCache::find(key, text->_text);
+        if (text->_run) continue;
+
+        // Texts whose hashes collide get a job of their own
+        auto [it, inserted] = jobByKey.emplace(key, jobs.size());
+        if (!inserted && jobs[it->second].text->_text != text->_text) {
+            pending.emplace_back(text, jobs.size());
+            jobs.push_back(Job{key, text, text->_font.metrics(), ShapedRun{}});
+            continue;
         }
+        if (inserted) jobs.push_back(Job{key, text, text->_font.metrics(), ShapedRun{}});
+        pending.emplace_back(text, it->second);
+    }
 
-        // Advance horizontally
-        x += charData.advance * scale;
+    // Only layout itself runs on workers, it makes no GL calls and doesn't touch the cache
+    auto layoutJob = [&jobs](size_t i) {
+        Job &job = jobs[i];
+        job.run = job.text->computeLayout(*job.metrics);
+    };
+    if (_layoutThreads > 0 && jobs.size() > 1) {
+        if (!layoutPool) layoutPool = std::make_unique<TaskPool>(_layoutThreads);
+        layoutPool->parallelFor(jobs.size(), layoutJob);
+    } else {
+        for (size_t i = 0; i < jobs.size(); ++i) layoutJob(i);
     }
 
-    // Check if last element was a space
-    if (textSize > 0 && _text[textSize - 1] == ' ') {
-        x -= _font.getCharInfo(' ').advance * scale;
+    // Merge results back on this thread
+    std::vector<std::shared_ptr<const ShapedRun>> runs;
+    runs.reserve(jobs.size());
+    for (auto &job : jobs) {
+        runs.push_back(ShapedRunCache::insert(job.key, job.text->_text, std::move(job.run)));
     }
-    // Add last line
-    linesData.emplace_back(lastStart, textSize, _renderWidth - x + _topLeft.x, numWords);
+    for (auto [text, job] : pending) {
+        text->_run = runs[job];
+    }
+}
 
-    return linesData;
+std::shared_ptr<const ShapedRun> Text::layout() {
+    if (!_run) shape();
+    return _run;
+}
+
+bool Text::isLayoutDirty() const {
+    return !_run;
 }
 
 void Text::setText(const std::string &text) {
-    _text = text;
+    _text = TextBuffer{text};
+    _run.reset();
+}
+
+void Text::setText(const TextBuffer &text) {
+    _text = text.snapshot();
+    _run.reset();
 }
 
 std::string Text::text() const {
+    return _text.toString();
+}
+
+const TextBuffer &Text::buffer() const {
     return _text;
 }
 
 void Text::setFont(const Font &font) {
     _font = font;
+    _run.reset();
 }
 
 Font Text::font() const {
@@ -327,7 +372,9 @@ Font Text::font() const {
 }
 
 void Text::setFontSize(float fontSize) {
+    if (_fontSize == fontSize) return;
     _fontSize = fontSize;
+    _run.reset();
 }
 
 float Text::fontSize() const {
@@ -343,7 +390,9 @@ glm::vec2 Text::topLeft() const {
 }
 
 void Text::setRenderWidth(float renderWidth) {
+    if (_renderWidth == renderWidth) return;
     _renderWidth = renderWidth;
+    _run.reset();
 }
 
 float Text::renderWidth() const {
@@ -351,7 +400,9 @@ float Text::renderWidth() const {
 }
 
 void Text::setLineHeight(float lineHeight) {
+    if (_lineHeight == lineHeight) return;
     _lineHeight = lineHeight;
+    _run.reset();
 }
 
 float Text::lineHeight() const {
@@ -366,8 +417,23 @@ glm::vec4 Text::color() const {
     return _color;
 }
 
+void Text::setOutline(float width, const glm::vec4 &color) {
+    _outlineWidth = std::max(0.0f, width);
+    _outlineColor = color;
+}
+
+float Text::outlineWidth() const {
+    return _outlineWidth;
+}
+
+glm::vec4 Text::outlineColor() const {
+    return _outlineColor;
+}
+
 void Text::setAlignment(TextAlignment alignment) {
+    if (_alignment == alignment) return;
     _alignment = alignment;
+    _run.reset();
 }
 
 TextAlignment Text::alignment() const {
@@ -0,0 +1,438 @@
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+
+#include "text_buffer.hpp"
+
+/// @brief Size of each storage chunk, in bytes
+static constexpr size_t STORAGE_CHUNK_SIZE = 64 * 1024;
+
+struct TextBuffer::PieceCache {
+    /// @brief Pieces in buffer order
+    std::vector<std::string_view> pieces;
+
+    /// @brief Offset of each piece in the buffer
+    std::vector<size_t> offsets;
+};
+
+/// @brief A node of the piece tree (treap ordered by text position, heap-ordered by priority)
+/// @note Nodes are immutable once built, so subtrees can be freely shared between snapshots
+struct TextBuffer::Node {
+    Node(
+        const char *data,
+        size_t length,
+        uint32_t priority,
+        std::shared_ptr<const Node> left,
+        std::shared_ptr<const Node> right
+    ) : data{data}, length{length}, priority{priority}, left{std::move(left)}, right{std::move(right)} {
+        total = length;
+        if (Node::left) total += Node::left->total;
+        if (Node::right) total += Node::right->total;
+    }
+
+    /// @brief Start of this piece in storage
+    const char *data;
+
+    /// @brief Number of characters in this piece
+    size_t length;
+
+    /// @brief Random treap priority
+    uint32_t priority;
+
+    /// @brief Pieces before this one
+    std::shared_ptr<const Node> left;
+
+    /// @brief Pieces after this one
+    std::shared_ptr<const Node> right;
+
+    /// @brief Number of characters in this subtree
+    size_t total;
+};
+
+/// @brief Append-only text storage; written bytes are never moved or modified
+struct TextBuffer::Storage {
+    /// @brief Copies text into storage
+    /// @param text text to copy
+    /// @return pointer to stored text, valid while storage lives
+    const char *store(std::string_view text) {
+        // Big texts (like pasted ones) get their own chunk so the current one isn't wasted
+        if (text.size() > STORAGE_CHUNK_SIZE / 4) {
+            chunks.emplace_back(new char[text.size()]);
+            std::memcpy(chunks.back().get(), text.data(), text.size());
+            return chunks.back().get();
+        }
+
+        if (text.size() > remaining) {
+            chunks.emplace_back(new char[STORAGE_CHUNK_SIZE]);
+            cursor = chunks.back().get();
+            remaining = STORAGE_CHUNK_SIZE;
+        }
+
+        char *data = cursor;
+        std::memcpy(data, text.data(), text.size());
+        cursor += text.size();
+        remaining -= text.size();
+        return data;
+    }
+
+    /// @brief Whether storing text would place it right at a given address
+    /// @param end address to check
+    /// @param size size of text to store
+    /// @return whether stored text would be contiguous to end
+    bool continues(const char *end, size_t size) const {
+        return end == cursor && size <= remaining && size <= STORAGE_CHUNK_SIZE / 4;
+    }
+
+    /// @brief Allocated chunks
+    std::vector<std::unique_ptr<char[]>> chunks;
+
+    /// @brief Next free byte in current chunk
+    char *cursor = nullptr;
+
+    /// @brief Free bytes left in current chunk
+    size_t remaining = 0;
+};
+
+using NodePtr = std::shared_ptr<const TextBuffer::Node>;
+
+/// @brief Generates a pseudo-random treap priority
+/// @return priority
+static uint32_t nextPriority() {
+    thread_local uint32_t state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/// @brief Number of characters in a subtree
+static size_t totalOf(const NodePtr &node) {
+    return node ? node->total : 0;
+}
+
+/// @brief Splits a tree at a character position, cutting a piece in two if needed
+/// @param node tree root
+/// @param pos character index at which right tree starts
+/// @param left output tree with characters before pos
+/// @param right output tree with characters from pos onwards
+static void split(const NodePtr &node, size_t pos, NodePtr &left, NodePtr &right) {
+    if (pos == 0) {
+        left = nullptr;
+        right = node;
+        return;
+    }
+    if (pos >= totalOf(node)) {
+        left = node;
+        right = nullptr;
+        return;
+    }
+
+    const size_t leftSize = totalOf(node->left);
+    if (pos <= leftSize) {
+        NodePtr l, r;
+        split(node->left, pos, l, r);
+        left = l;
+        right = std::make_shared<const TextBuffer::Node>(node->data, node->length, node->priority, r, node->right);
+    } else if (pos >= leftSize + node->length) {
+        NodePtr l, r;
+        split(node->right, pos - leftSize - node->length, l, r);
+        left = std::make_shared<const TextBuffer::Node>(node->data, node->length, node->priority, node->left, l);
+        right = r;
+    } else {
+        // Cut piece; both halves keep the priority so heap order still holds
+        const size_t offset = pos - leftSize;
+        left = std::make_shared<const TextBuffer::Node>(node->data, offset, node->priority, node->left, nullptr);
+        right = std::make_shared<const TextBuffer::Node>(
+            node->data + offset, node->length - offset, node->priority, nullptr, node->right
+        );
+    }
+}
+
+/// @brief Concatenates two trees
+/// @param left tree with first characters
+/// @param right tree with last characters
+/// @return merged tree
+static NodePtr merge(const NodePtr &left, const NodePtr &right) {
+    if (!left) return right;
+    if (!right) return left;
+
+    if (left->priority > right->priority) {
+        return std::make_shared<const TextBuffer::Node>(
+            left->data, left->length, left->priority, left->left, merge(left->right, right)
+        );
+    }
+    return std::make_shared<const TextBuffer::Node>(
+        right->data, right->length, right->priority, merge(left, right->left), right->right
+    );
+}
+
+/// @brief Gets the last piece of a tree
+static const TextBuffer::Node *lastPiece(const NodePtr &node) {
+    const TextBuffer::Node *current = node.get();
+    while (current && current->right) current = current->right.get();
+    return current;
+}
+
+/// @brief Grows the last piece of a tree
+/// @param node tree root
+/// @param count number of characters to add to last piece
+/// @return new tree
+static NodePtr extendLast(const NodePtr &node, size_t count) {
+    if (node->right) {
+        return std::make_shared<const TextBuffer::Node>(
+            node->data, node->length, node->priority, node->left, extendLast(node->right, count)
+        );
+    }
+    return std::make_shared<const TextBuffer::Node>(
+        node->data, node->length + count, node->priority, node->left, nullptr
+    );
+}
+
+/// @brief Appends all pieces of a tree to a list, in order
+static void collectPieces(const TextBuffer::Node *node, std::vector<std::string_view> &pieces) {
+    while (node) {
+        collectPieces(node->left.get(), pieces);
+        pieces.emplace_back(node->data, node->length);
+        node = node->right.get();
+    }
+}
+
+TextBuffer::TextBuffer() : _storage{std::make_shared<Storage>()} {}
+
+TextBuffer::TextBuffer(const std::string &text) : TextBuffer{} {
+    append(text);
+}
+
+TextBuffer::TextBuffer(const TextBuffer &buffer)
+    : _root{buffer._root}, _storage{buffer._storage}, _pieces{std::atomic_load(&buffer._pieces)} {}
+
+TextBuffer &TextBuffer::operator= (const TextBuffer &buffer) {
+    _root = buffer._root;
+    _storage = buffer._storage;
+    _pieces = std::atomic_load(&buffer._pieces);
+    return *this;
+}
+
+void TextBuffer::insert(size_t pos, std::string_view text) {
+    if (text.empty()) return;
+    pos = std::min(pos, size());
+    _pieces = nullptr;
+
+    NodePtr left, right;
+    split(_root, pos, left, right);
+
+    // Typing sequentially writes contiguous bytes, so just grow the previous piece when possible
+    const Node *last = lastPiece(left);
+    if (last && _storage->continues(last->data + last->length, text.size())) {
+        _storage->store(text);
+        _root = merge(extendLast(left, text.size()), right);
+        return;
+    }
+
+    const char *data = _storage->store(text);
+    auto node = std::make_shared<const Node>(data, text.size(), nextPriority(), nullptr, nullptr);
+    _root = merge(merge(left, node), right);
+}
+
+void TextBuffer::append(std::string_view text) {
+    insert(size(), text);
+}
+
+void TextBuffer::erase(size_t pos, size_t count) {
+    if (pos >= size() || count == 0) return;
+    count = std::min(count, size() - pos);
+    _pieces = nullptr;
+
+    NodePtr left, right, middle, rest;
+    split(_root, pos, left, right);
+    split(right, count, middle, rest);
+    _root = merge(left, rest);
+}
+
+void TextBuffer::clear() {
+    _root = nullptr;
+    _pieces = nullptr;
+}
+
+TextBuffer TextBuffer::snapshot() const {
+    return *this;
+}
+
+size_t TextBuffer::size() const {
+    return totalOf(_root);
+}
+
+bool TextBuffer::empty() const {
+    return _root == nullptr;
+}
+
+char TextBuffer::at(size_t pos) const {
+    const Node *node = _root.get();
+    while (node) {
+        const size_t leftSize = totalOf(node->left);
+        if (pos < leftSize) {
+            node = node->left.get();
+        } else if (pos < leftSize + node->length) {
+            return node->data[pos - leftSize];
+        } else {
+            pos -= leftSize + node->length;
+            node = node->right.get();
+        }
+    }
+    return '\0';
+}
+
+size_t TextBuffer::rfind(char c) const {
+    const auto &list = pieces();
+
+    size_t end = size();
+    for (auto it = list.rbegin(); it != list.rend(); ++it) {
+        end -= it->size();
+        size_t idx = it->rfind(c);
+        if (idx != std::string_view::npos) return end + idx;
+    }
+    return std::string::npos;
+}
+
+std::string TextBuffer::toString() const {
+    return substr(0);
+}
+
+uint64_t TextBuffer::hash() const {
+    uint64_t hash = 14695981039346656037ull;
+    for (auto piece : pieces()) {
+        for (char c : piece) {
+            hash ^= (unsigned char)c;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+bool TextBuffer::operator== (const TextBuffer &buffer) const {
+    if (_root == buffer._root) return true;
+    if (size() != buffer.size()) return false;
+
+    // Pieces of both buffers may be split at different places
+    const auto &a = pieces(), &b = buffer.pieces();
+    size_t i = 0, j = 0, offsetA = 0, offsetB = 0;
+    while (i < a.size() && j < b.size()) {
+        const size_t count = std::min(a[i].size() - offsetA, b[j].size() - offsetB);
+        if (a[i].compare(offsetA, count, b[j], offsetB, count) != 0) return false;
+        offsetA += count;
+        offsetB += count;
+        if (offsetA == a[i].size()) { ++i; offsetA = 0; }
+        if (offsetB == b[j].size()) { ++j; offsetB = 0; }
+    }
+    return true;
+}
+
+bool TextBuffer::operator!= (const TextBuffer &buffer) const {
+    return !(*this == buffer);
+}
+
+std::string TextBuffer::substr(size_t pos, size_t count) const {
+    std::string result;
+    if (pos >= size()) return result;
+    count = std::min(count, size() - pos);
+    result.reserve(count);
+
+    for (auto piece : pieces()) {
+        if (count == 0) break;
+        if (pos >= piece.size()) {
+            pos -= piece.size();
+            continue;
+        }
+
+        piece = piece.substr(pos, count);
+        result.append(piece);
+        count -= piece.size();
+        pos = 0;
+    }
+    return result;
+}
+
+const TextBuffer::PieceCache &TextBuffer::pieceCache() const {
+    auto cache = std::atomic_load(&_pieces);
+    if (!cache) {
+        auto built = std::make_shared<PieceCache>();
+        collectPieces(_root.get(), built->pieces);
+
+        built->offsets.reserve(built->pieces.size());
+        size_t offset = 0;
+        for (auto piece : built->pieces) {
+            built->offsets.push_back(offset);
+            offset += piece.size();
+        }
+
+        // Readers racing to build it keep whichever cache was published first, so references
+        // handed out to other threads are never released
+        cache = built;
+        std::shared_ptr<const PieceCache> expected;
+        if (!std::atomic_compare_exchange_strong(&_pieces, &expected, cache)) cache = expected;
+    }
+    return *cache;
+}
+
+const std::vector<std::string_view> &TextBuffer::pieces() const {
+    return pieceCache().pieces;
+}
+
+TextBuffer::Iterator TextBuffer::begin() const {
+    return Iterator{&pieces(), 0};
+}
+
+TextBuffer::Iterator TextBuffer::end() const {
+    const auto &list = pieces();
+    Iterator it{&list, list.size()};
+    it._position = size();
+    return it;
+}
+
+TextBuffer::Iterator TextBuffer::iteratorAt(size_t pos) const {
+    if (pos >= size()) return end();
+
+    // Find last piece starting at or before pos
+    const PieceCache &cache = pieceCache();
+    auto it = std::upper_bound(cache.offsets.begin(), cache.offsets.end(), pos);
+    const size_t pieceIdx = (it - cache.offsets.begin()) - 1;
+
+    Iterator result{&cache.pieces, pieceIdx};
+    result._offset = pos - cache.offsets[pieceIdx];
+    result._position = pos;
+    return result;
+}
+
+TextBuffer::Iterator::Iterator(const std::vector<std::string_view> *pieces, size_t pieceIdx)
+    : _pieces{pieces}, _pieceIdx{pieceIdx} {}
+
+TextBuffer::Iterator::reference TextBuffer::Iterator::operator* () const {
+    return (*_pieces)[_pieceIdx][_offset];
+}
+
+TextBuffer::Iterator &TextBuffer::Iterator::operator++ () {
+    ++_position;
+    if (++_offset == (*_pieces)[_pieceIdx].size()) {
+        _offset = 0;
+        ++_pieceIdx;
+    }
+    return *this;
+}
+
+TextBuffer::Iterator TextBuffer::Iterator::operator++ (int) {
+    Iterator tmp{*this};
+    ++*this;
+    return tmp;
+}
+
+bool TextBuffer::Iterator::operator== (const Iterator &it) const {
+    return _pieces == it._pieces && _pieceIdx == it._pieceIdx && _offset == it._offset;
+}
+
+bool TextBuffer::Iterator::operator!= (const Iterator &it) const {
+    return !(*this == it);
+}
+
+size_t TextBuffer::Iterator::position() const {
+    return _position;
+}
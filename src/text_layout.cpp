@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include "text_layout.hpp"
+#include "utf8.hpp"
+
+TextLayout::TextLayout(
+    const FontMetrics &metrics,
+    float fontSize,
+    float renderWidth,
+    float lineHeight,
+    TextAlignment alignment
+) : _metrics{metrics}, _fontSize{fontSize}, _renderWidth{renderWidth}, _lineHeight{lineHeight}, _alignment{alignment} {}
+
+std::vector<TextLayout::Line> TextLayout::lines(const TextBuffer &text) const {
+    std::vector<Line> linesData;
+
+    const float spaceAdvance = _metrics.advance(' ') * (_fontSize / _metrics.fontHeight());
+    size_t lastStart = 0;
+    size_t numWords = 0;
+    bool previousSpace = false;
+
+    // Keep track of current position, relative to top-left
+    float x = 0.0f;
+
+    // Words are measured as whole spans straight from the buffer pieces, so ASCII runs go through the
+    // advance kernels. They're only copied if they span several pieces
+    const auto &pieces = text.pieces();
+    size_t pieceIdx = 0;
+    size_t offset = 0;
+    size_t i = 0;
+    std::string joined;
+    std::vector<float> widths;
+    while (pieceIdx < pieces.size()) {
+        std::string_view piece = pieces[pieceIdx];
+        if (offset == piece.size()) {
+            ++pieceIdx;
+            offset = 0;
+            continue;
+        }
+
+        // Skip space char
+        if (piece[offset] == ' ') {
+            x += spaceAdvance;
+            previousSpace = true;
+            ++numWords;
+            ++offset;
+            ++i;
+            continue;
+        }
+
+        // Take word until next space (or end of text)
+        size_t wordEnd = std::min(piece.find(' ', offset), piece.size());
+        std::string_view word = piece.substr(offset, wordEnd - offset);
+        offset = wordEnd;
+        if (offset == piece.size() && pieceIdx + 1 < pieces.size()) {
+            joined.assign(word);
+            while (++pieceIdx < pieces.size()) {
+                piece = pieces[pieceIdx];
+                wordEnd = std::min(piece.find(' '), piece.size());
+                joined.append(piece.substr(0, wordEnd));
+                offset = wordEnd;
+                if (wordEnd != piece.size()) break;
+            }
+            word = joined;
+        }
+
+        // Check if word overflows width
+        const float wordWidth = _metrics.textWidth(word, _fontSize);
+        if (i != 0 && x + wordWidth > _renderWidth) {
+            // Check if last element was a space
+            if (previousSpace) {
+                x -= spaceAdvance;
+            }
+
+            // Add new line data entry to vector
+            linesData.emplace_back(lastStart, i, _renderWidth - x, numWords);
+
+            // Reset position data
+            numWords = 0;
+            lastStart = i;
+            x = 0.0f;
+        }
+
+        if (x + wordWidth <= _renderWidth) {
+            x += wordWidth;
+        } else {
+            // Word doesn't fit in a whole line, so it's broken before every codepoint that overflows.
+            // The first codepoint on a line always stays, however wide
+            widths.resize(word.size() + 1);
+            _metrics.prefixWidths(word, _fontSize, widths.data());
+
+            // Position at byte k of word is origin + widths[k]
+            float origin = x;
+            auto it = word.begin();
+            decodeUtf8(it, word.end());
+            size_t firstEnd = it - word.begin();
+            while (firstEnd < word.size()) {
+                auto overflow = std::upper_bound(
+                    widths.begin() + firstEnd + 1,
+                    widths.end(),
+                    _renderWidth - origin
+                );
+                if (overflow == widths.end()) break;
+
+                // Find the overflowing codepoint, walking from the last one that fit
+                const size_t overflowIdx = overflow - widths.begin();
+                size_t start;
+                do {
+                    start = it - word.begin();
+                    decodeUtf8(it, word.end());
+                } while ((size_t)(it - word.begin()) < overflowIdx);
+
+                // Break before it, it's the first codepoint on the new line
+                linesData.emplace_back(lastStart, i + start, _renderWidth - (origin + widths[start]), numWords);
+                numWords = 0;
+                lastStart = i + start;
+                origin = -widths[start];
+                firstEnd = it - word.begin();
+            }
+            x = origin + widths[word.size()];
+        }
+
+        previousSpace = false;
+        i += word.size();
+    }
+
+    // Check if last element was a space
+    if (previousSpace) {
+        x -= spaceAdvance;
+    }
+    // Add last line
+    linesData.emplace_back(lastStart, text.size(), _renderWidth - x, numWords);
+
+    return linesData;
+}
+
+ShapedRun TextLayout::layout(const TextBuffer &text) const {
+    ShapedRun run;
+    float scale = _fontSize / _metrics.fontHeight();
+
+    // Calculate lines data to adjust to current alignment
+    auto linesData = lines(text);
+    const float numLines = linesData.size();
+
+    // Keep track of current render position, relative to top-left
+    const float fontOffsetY = _metrics.maxCharHeight() - _metrics.maxCharUnderflow();
+    float x = 0.0f;
+    float y = 0.0f;
+    size_t currentLine = 0;
+    float wordSpacing = 0.0f;
+
+    // Check for alignment
+    switch (_alignment) {
+    case TextAlignment::left:
+        // Left is the default, don't change anything
+        break;
+    case TextAlignment::right:
+        // Put line spacing at the start
+        x += linesData[currentLine].spacing;
+        break;
+    case TextAlignment::center:
+        // Put half the line spacing at the start
+        x += linesData[currentLine].spacing * 0.5f;
+        break;
+    case TextAlignment::justified:
+        // No spacing is put at the start, only between words/chars
+        wordSpacing = linesData[currentLine].spacing / (float)(linesData[currentLine].numWords - 1);
+        break;
+    }
+    run.lines.push_back(ShapedLine{linesData[0].startIdx, linesData[0].endIdx, 0, glm::vec4{0.0f}});
+
+    for (auto it = text.begin(), end = text.end(); it != end;) {
+        const size_t i = it.position();
+        uint32_t c = decodeUtf8(it, end);
+        const float advance = _metrics.advance(c);
+
+        // Skip space char
+        if (c == ' ' && linesData[currentLine].endIdx != i) {
+            x += advance * scale;
+            if (currentLine != numLines - 1) {
+                x += wordSpacing;
+            }
+            continue;
+        }
+
+        // Check if need to go to next line
+        if (linesData[currentLine].endIdx == i) {
+            // Reset position and go to next line
+            y += _fontSize * _lineHeight;
+            x = 0.0f;
+            ++currentLine;
+            wordSpacing = 0.0f;
+            run.lines.push_back(ShapedLine{
+                linesData[currentLine].startIdx,
+                linesData[currentLine].endIdx,
+                run.glyphs.size(),
+                glm::vec4{0.0f}
+            });
+
+            // Check for alignment on next line
+            switch (_alignment) {
+            case TextAlignment::left:
+                // Left is the default, don't change anything
+                break;
+            case TextAlignment::right:
+                // Put line spacing at the start
+                x += linesData[currentLine].spacing;
+                break;
+            case TextAlignment::center:
+                // Put half the line spacing at the start
+                x += linesData[currentLine].spacing * 0.5f;
+                break;
+            case TextAlignment::justified:
+                // No spacing is put at the start, only between words/chars
+                wordSpacing = linesData[currentLine].spacing / (float)(linesData[currentLine].numWords - 1);
+                break;
+            }
+        }
+
+        // Spaces starting a line have nothing to draw
+        if (c != ' ') {
+            run.glyphs.push_back(PlacedGlyph{c, glm::vec2{x, y + fontOffsetY * scale}});
+        }
+
+        // Change render position
+        x += advance * scale;
+    }
+
+    // Line boxes, justified lines (but the last one) span the whole render width
+    const float lineAdvance = _fontSize * _lineHeight;
+    float minX = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    for (size_t i = 0; i < run.lines.size(); ++i) {
+        const Line &line = linesData[i];
+        float start = 0.0f;
+        float width = _renderWidth - line.spacing;
+        if (_alignment == TextAlignment::right) {
+            start = line.spacing;
+        } else if (_alignment == TextAlignment::center) {
+            start = line.spacing * 0.5f;
+        } else if (_alignment == TextAlignment::justified && i != numLines - 1 && line.numWords > 1) {
+            width = _renderWidth;
+        }
+        run.lines[i].bounds = glm::vec4{start, i * lineAdvance, width, lineAdvance};
+        minX = std::min(minX, start);
+        maxX = std::max(maxX, start + width);
+    }
+    run.bounds = glm::vec4{minX, 0.0f, std::max(0.0f, maxX - minX), run.lines.size() * lineAdvance};
+
+    return run;
+}
+
+float TextLayout::fontSize() const {
+    return _fontSize;
+}
+
+float TextLayout::renderWidth() const {
+    return _renderWidth;
+}
+
+float TextLayout::lineHeight() const {
+    return _lineHeight;
+}
+
+TextAlignment TextLayout::alignment() const {
+    return _alignment;
+}
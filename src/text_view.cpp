@@ -0,0 +1,336 @@
+#include <cstring>
+#include <algorithm>
+
+#include "glad/glad.h"
+
+#include "batch.hpp"
+#include "debug.hpp"
+#include "text.hpp"
+#include "text_view.hpp"
+#include "utf8.hpp"
+
+TextView::TextView(const TextBuffer &text, const Font &font) : _font{font} {
+    setText(text);
+}
+
+void TextView::draw(const glm::vec2 &windowSize) {
+    if (_lineStarts.empty() || _size.x <= 0.0f || _size.y <= 0.0f) return;
+    ++_frame;
+
+    const float scale = _fontSize / _font.fontHeight();
+    const float fontOffsetY = (_font.maxCharHeight() - _font.maxCharUnderflow()) * scale;
+    const float height = rowHeight();
+    const float bottom = _topLeft.y + _size.y;
+
+    // Clip to viewport (scissor box origin is at bottom left), batched draws so far must not be clipped
+    BatchModule::flush();
+    glEnable(GL_SCISSOR_TEST); glCheckError();
+    glScissor(
+        (int)_topLeft.x,
+        (int)(windowSize.y - bottom),
+        (int)_size.x,
+        (int)_size.y
+    ); glCheckError();
+
+    TextModule::beginGlyphs(windowSize, _color, _font.renderMode());
+
+    // Find first visible line, then draw lines until viewport bottom
+    size_t line = lineAtRow((size_t)(_scroll / height));
+    float y = _topLeft.y - _scroll + rowsBefore(line) * height;
+    while (line < numLines() && y < bottom) {
+        LineLayout &layout = layoutLine(line);
+        layout.lastFrame = _frame;
+
+        // Skip rows above viewport, glyphs are sorted by row
+        uint32_t firstRow = y < _topLeft.y ? (uint32_t)((_topLeft.y - y) / height) : 0;
+        auto it = std::partition_point(
+            layout.glyphs.begin(),
+            layout.glyphs.end(),
+            [firstRow](const Glyph &glyph) { return glyph.row < firstRow; }
+        );
+
+        for (; it != layout.glyphs.end(); ++it) {
+            float rowY = y + it->row * height;
+            if (rowY >= bottom) break;
+
+            glm::vec2 baseline{_topLeft.x + it->x, rowY + fontOffsetY};
+            TextModule::drawGlyph(_font.getGlyph(it->codepoint), baseline, scale);
+        }
+
+        y += layout.rows * height;
+        ++line;
+    }
+
+    TextModule::endGlyphs();
+    BatchModule::flush();
+    glDisable(GL_SCISSOR_TEST); glCheckError();
+
+    evictLines();
+}
+
+void TextView::setText(const TextBuffer &text) {
+    _text = text.snapshot();
+    rebuildIndex();
+}
+
+const TextBuffer &TextView::text() const {
+    return _text;
+}
+
+void TextView::setFont(const Font &font) {
+    _font = font;
+    resetLayout();
+}
+
+Font TextView::font() const {
+    return _font;
+}
+
+void TextView::setFontSize(float fontSize) {
+    _fontSize = fontSize;
+    resetLayout();
+}
+
+float TextView::fontSize() const {
+    return _fontSize;
+}
+
+void TextView::setLineHeight(float lineHeight) {
+    // Line height only moves rows, no need to lay out again
+    _lineHeight = std::max(0.0f, lineHeight);
+    setScroll(_scroll);
+}
+
+float TextView::lineHeight() const {
+    return _lineHeight;
+}
+
+void TextView::setColor(const glm::vec4 &color) {
+    _color = color;
+}
+
+glm::vec4 TextView::color() const {
+    return _color;
+}
+
+void TextView::setTopLeft(const glm::vec2 &topLeft) {
+    _topLeft = topLeft;
+}
+
+glm::vec2 TextView::topLeft() const {
+    return _topLeft;
+}
+
+void TextView::setSize(const glm::vec2 &size) {
+    bool widthChanged = size.x != _size.x;
+    _size = size;
+
+    if (widthChanged && _wrap) {
+        resetLayout();
+    } else {
+        setScroll(_scroll);
+    }
+}
+
+glm::vec2 TextView::size() const {
+    return _size;
+}
+
+void TextView::setWrap(bool wrap) {
+    _wrap = wrap;
+    resetLayout();
+}
+
+bool TextView::wrap() const {
+    return _wrap;
+}
+
+void TextView::setScroll(float scroll) {
+    float maxScroll = std::max(0.0f, contentHeight() - _size.y);
+    _scroll = std::clamp(scroll, 0.0f, maxScroll);
+}
+
+void TextView::scrollBy(float delta) {
+    setScroll(_scroll + delta);
+}
+
+float TextView::scroll() const {
+    return _scroll;
+}
+
+float TextView::contentHeight() const {
+    return rowsBefore(numLines()) * rowHeight();
+}
+
+size_t TextView::numLines() const {
+    return _lineStarts.size();
+}
+
+void TextView::setMaxCachedGlyphs(size_t maxCachedGlyphs) {
+    _maxCachedGlyphs = maxCachedGlyphs;
+    evictLines();
+}
+
+size_t TextView::maxCachedGlyphs() const {
+    return _maxCachedGlyphs;
+}
+
+size_t TextView::cachedGlyphs() const {
+    return _cachedGlyphs;
+}
+
+void TextView::rebuildIndex() {
+    _lineStarts.clear();
+    _lineStarts.push_back(0);
+
+    // Scan pieces for line breaks
+    size_t offset = 0;
+    for (auto piece : _text.pieces()) {
+        const char *start = piece.data();
+        const char *end = start + piece.size();
+        for (const char *p = start; (p = (const char *)std::memchr(p, '\n', end - p)) != nullptr; ++p) {
+            _lineStarts.push_back(offset + (p - start) + 1);
+        }
+        offset += piece.size();
+    }
+
+    resetLayout();
+}
+
+void TextView::resetLayout() {
+    _layouts.clear();
+    _lru.clear();
+    _cachedGlyphs = 0;
+
+    // Every line is estimated as a single row until laid out
+    const size_t n = numLines();
+    _lineRows.assign(n, 1);
+    _rowTree.assign(n + 1, 0);
+    for (size_t i = 1; i <= n; ++i) {
+        _rowTree[i] = i & -i;
+    }
+
+    setScroll(_scroll);
+}
+
+TextView::LineLayout &TextView::layoutLine(size_t line) {
+    // Check if already laid out
+    auto found = _layouts.find(line);
+    if (found != _layouts.end()) {
+        _lru.splice(_lru.begin(), _lru, found->second.lruIt);
+        return found->second;
+    }
+
+    const size_t start = _lineStarts[line];
+    const size_t end = line + 1 < numLines() ? _lineStarts[line + 1] - 1 : _text.size();
+    const float scale = _fontSize / _font.fontHeight();
+
+    LineLayout layout;
+    uint32_t row = 0;
+    float x = 0.0f;
+
+    // Current word start, so it can be moved down as a whole
+    size_t wordStart = 0;
+    float wordStartX = 0.0f;
+    bool inWord = false;
+
+    for (auto it = _text.iteratorAt(start), itEnd = _text.iteratorAt(end); it != itEnd;) {
+        uint32_t c = decodeUtf8(it, itEnd);
+        if (c == '\r') continue;
+
+        float advance = _font.getCharInfo(c).advance * scale;
+        if (c == ' ') {
+            x += advance;
+            inWord = false;
+            continue;
+        }
+
+        if (!inWord) {
+            inWord = true;
+            wordStart = layout.glyphs.size();
+            wordStartX = x;
+        }
+
+        while (_wrap && x > 0.0f && x + advance > _size.x) {
+            ++row;
+            if (wordStartX > 0.0f) {
+                // Move whole word to next row
+                for (size_t i = wordStart; i < layout.glyphs.size(); ++i) {
+                    layout.glyphs[i].row = row;
+                    layout.glyphs[i].x -= wordStartX;
+                }
+                x -= wordStartX;
+            } else {
+                // Word doesn't fit a row by itself, break it here
+                wordStart = layout.glyphs.size();
+                x = 0.0f;
+            }
+            wordStartX = 0.0f;
+        }
+
+        layout.glyphs.push_back(Glyph{c, row, x});
+        x += advance;
+    }
+    layout.rows = row + 1;
+    layout.glyphs.shrink_to_fit();
+
+    // Correct row estimate
+    if (_lineRows[line] != layout.rows) {
+        setLineRows(line, layout.rows);
+    }
+
+    _cachedGlyphs += layout.glyphs.size();
+    _lru.push_front(line);
+    layout.lruIt = _lru.begin();
+    return _layouts.emplace(line, std::move(layout)).first->second;
+}
+
+void TextView::evictLines() {
+    while (_cachedGlyphs > _maxCachedGlyphs && !_lru.empty()) {
+        auto it = _layouts.find(_lru.back());
+
+        // Remaining lines are all visible
+        if (it->second.lastFrame == _frame) break;
+
+        _cachedGlyphs -= it->second.glyphs.size();
+        _layouts.erase(it);
+        _lru.pop_back();
+    }
+}
+
+float TextView::rowHeight() const {
+    return std::max(1.0f, _fontSize * _lineHeight);
+}
+
+size_t TextView::rowsBefore(size_t line) const {
+    size_t rows = 0;
+    for (size_t i = std::min(line, numLines()); i > 0; i -= i & -i) {
+        rows += _rowTree[i];
+    }
+    return rows;
+}
+
+size_t TextView::lineAtRow(size_t row) const {
+    const size_t n = numLines();
+    size_t step = 1;
+    while (step * 2 <= n) step *= 2;
+
+    // Descend the tree, skipping lines whose rows are all before the given one
+    size_t pos = 0;
+    for (; step > 0; step >>= 1) {
+        if (pos + step <= n && _rowTree[pos + step] <= row) {
+            pos += step;
+            row -= _rowTree[pos];
+        }
+    }
+    return pos;
+}
+
+void TextView::setLineRows(size_t line, uint32_t rows) {
+    // Unsigned wrap-around makes a negative delta work as well
+    const size_t delta = (size_t)rows - (size_t)_lineRows[line];
+    _lineRows[line] = rows;
+    for (size_t i = line + 1; i < _rowTree.size(); i += i & -i) {
+        _rowTree[i] += delta;
+    }
+}
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <cstring>
+#include <cmath>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -8,52 +10,82 @@
 #include "glad/glad.h"
 #include "stb/stb_image.h"
 
+#include "animation.hpp"
 #include "application.hpp"
+#include "batch.hpp"
 #include "shader.hpp"
 #include "quad.hpp"
 #include "debug.hpp"
 #include "text.hpp"
+#include "text_view.hpp"
+#include "utf8.hpp"
 
 #ifndef PROJECT_ROOT_FOLDER
 #define PROJECT_ROOT_FOLDER "."
 #endif
 
+/// @brief Longest wait for input while no animation runs, in seconds
+static constexpr double IDLE_FRAME_TIME = 1.0 / 20.0;
+
 class App : public Application {
 public:
     App();
 
     void start() override;
-    void framebufferSizeCallback(int width, int height) override;
     void charCallback(unsigned int codepoint) override;
     void keyCallback(int key, int scancode, int action, int mods) override;
+    void scrollCallback(double xoffset, double yoffset) override;
 
-    std::vector<std::shared_ptr<Quad>> quads;
+    /// @brief Rounded quad, spun a quarter turn with UP
+    QuadHandle quadHandle;
 
     Text textBox;
-    std::string text;
+    TextBuffer text;
+
+    /// Snapshots of text before each edit, for undo
+    std::vector<TextBuffer> history;
+
+    /// Huge scrollable log, toggled with TAB
+    TextView logView;
+    bool showLog = false;
 };
 
 App::App() : Application::Application{PROJECT_ROOT_FOLDER, "Rounded Quads", 600, 600} {}
 
-void App::framebufferSizeCallback(int width, int height) {
-    Application::framebufferSizeCallback(width, height);
+void App::charCallback(unsigned int codepoint) {
+    if (codepoint < CHARS_START) return;
 
-    // Call window resize callback for each quad
-    glm::vec2 windowSize{(float)width, (float)height};
-    for (auto &quad : quads) {
-        quad->onWindowResize(windowSize);
-    }
+    std::string encoded;
+    encodeUtf8(codepoint, encoded);
+
+    history.push_back(text.snapshot());
+    text.append(encoded);
 }
 
-void App::charCallback(unsigned int codepoint) {
-    if (codepoint < CHARS_START || codepoint > CHARS_START + CHARS_LEN) return;
+void App::scrollCallback(double xoffset, double yoffset) {
+    (void)xoffset;
 
-    text += (char)codepoint;
+    logView.scrollBy(-yoffset * logView.fontSize() * 3.0f);
 }
 
 void App::keyCallback(int key, int scancode, int action, int mods) {
     (void)scancode;
 
+    if (action == GLFW_PRESS && key == GLFW_KEY_TAB) {
+        showLog = !showLog;
+        return;
+    }
+
+    if (action == GLFW_PRESS && key == GLFW_KEY_UP) {
+        // Quarter turn from wherever the previous one left off
+        if (Quad *quad = QuadModule::get(quadHandle)) {
+            const float quarter = glm::radians(90.0f);
+            const float target = (std::round(quad->rotation() / quarter) + 1.0f) * quarter;
+            Animations::animateRotation(quadHandle, target, (float)glfwGetTime(), 0.4f, Easing::easeOut);
+        }
+        return;
+    }
+
     bool ctrlPressed = false;
     if (mods & GLFW_MOD_CONTROL) {
         ctrlPressed = true;
@@ -71,14 +103,25 @@ void App::keyCallback(int key, int scancode, int action, int mods) {
 
     if (ctrlPressed && action == GLFW_PRESS && key == GLFW_KEY_V) {
         auto str = glfwGetClipboardString(window);
-        printf("clipboard str: \"%s\"\n", str);
+        if (str == nullptr) return;
+        printf("clipboard str: %zu chars\n", std::strlen(str));
 
-        text += str;
+        history.push_back(text.snapshot());
+        text.append(str);
+        return;
+    }
+
+    // Undo last edit
+    if (ctrlPressed && action != GLFW_RELEASE && key == GLFW_KEY_Z) {
+        if (!history.empty()) {
+            text = history.back();
+            history.pop_back();
+        }
         return;
     }
 
     // If key is backspace and action is not release, remove last char
-    if (action != GLFW_RELEASE && key == GLFW_KEY_BACKSPACE) {
+    if (action != GLFW_RELEASE && key == GLFW_KEY_BACKSPACE && !text.empty()) {
         size_t size;
         // If CTRL was pressed delete whole word or until last space
         if (ctrlPressed) {
@@ -89,9 +132,14 @@ void App::keyCallback(int key, int scancode, int action, int mods) {
                 size = idx;
             }
         } else {
+            // Remove a whole UTF-8 sequence, skipping continuation bytes
             size = text.size() - 1;
+            while (size > 0 && ((uint8_t)text.at(size) & 0xC0) == 0x80) {
+                --size;
+            }
         }
-        text = text.substr(0, size);
+        history.push_back(text.snapshot());
+        text.erase(size);
     }
 }
 
@@ -107,7 +155,8 @@ void App::start() {
     glm::vec2 windowSize{width(), height()};
 
     // Create quad
-    auto quad = std::make_shared<Quad>(windowSize);
+    quadHandle = QuadModule::create();
+    Quad *quad = QuadModule::get(quadHandle);
     quad->setSize(Dim2::fromScale(0.5f, 0.5f));
     quad->setPosition(Dim2::fromScale(0.5f, 0.5f));
     quad->setAnchorPoint(glm::vec2{0.5f});
@@ -117,14 +166,27 @@ void App::start() {
             Dim::fromScale(0.5f)
         ))
     );
-    quads.push_back(quad);
+    scene.addChild(quadHandle);
 
-    Font font{"resources/fonts/minecraft.ttf"};
+    Font font{"resources/fonts/minecraft.ttf", 48.0f, true};
+    Font sdfFont{"resources/fonts/roboto.ttf", 48.0f, true, GlyphRenderMode::sdf};
     textBox = Text{
         "Most words are short & don't need to break. But Antidisestablishmentarianism is long. The width is set to min-content, with a max-width of 11em. ",
-        font
+        sdfFont
     };
     textBox.setRenderWidth(300.0f);
+    textBox.setFontSize(32.0f);
+    textBox.setOutline(2.0f, glm::vec4{0.0f, 0.0f, 0.0f, 1.0f});
+
+    // Generate a big log to be shown on a virtualized view
+    TextBuffer log;
+    for (int i = 0; i < 50000; ++i) {
+        std::stringstream line;
+        line << "[" << i << "] worker " << i % 7 << " processed batch of " << (i * 37) % 1000 << " items\n";
+        log.append(line.str());
+    }
+    logView = TextView{log, font};
+    logView.setFontSize(16.0f);
 
     // Render loop
     // -----------
@@ -146,9 +208,13 @@ void App::start() {
             setWidth(width() + 1);
         }
 
+        // Advance animations, knowing whether the loop can sleep afterwards
+        const bool animating = Animations::update(now);
+
         // Update title
         std::stringstream sstr;
-        sstr << "Rounded Quads | " << (int)(1 / dt) << " fps";
+        sstr << "Rounded Quads | " << (int)(1 / dt) << " fps | " << BatchModule::drawCalls() << " draw calls";
+        if (!animating) sstr << " | idle";
         setTitle(sstr.str().c_str());
 
         windowSize = glm::vec2{(float)width(), (float)height()};
@@ -174,9 +240,9 @@ void App::start() {
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f); glCheckError();
         glClear(GL_COLOR_BUFFER_BIT); glCheckError();
 
-        for (auto const &quad : quads) {
-            quad->draw(windowSize);
-        }
+        // Quads and text go to a single ordered batch, split only by the log view scissor
+        BatchModule::begin(windowSize);
+        scene.draw(windowSize);
 
         float r = std::sin(now) * 0.5f + 0.5f;
         float g = std::cos(now * 4.0f) * 0.5f + 0.5f;
@@ -185,14 +251,30 @@ void App::start() {
         textBox.setText(text);
         textBox.draw(windowSize);
 
+        if (showLog) {
+            logView.setTopLeft(glm::vec2{0.0f, windowSize.y * 0.5f});
+            logView.setSize(glm::vec2{windowSize.x, windowSize.y * 0.5f});
+            logView.draw(windowSize);
+        }
+        BatchModule::end();
+
         // Swap buffers and poll events
         // ----------------------------
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        swapBuffers();
+
+        // With no animation running, sleep until input (text color still cycles, at a lower rate)
+        if (animating) {
+            glfwPollEvents();
+        } else {
+            glfwWaitEventsTimeout(IDLE_FRAME_TIME);
+        }
     }
 }
 
 int main() {
+    // Rasterize glyphs off the render thread
+    FontModule::setRasterizerThreads(2);
+
     auto app = std::make_shared<App>();
     app->start();
 }
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include "freetype/ft2build.h"
+#include FT_FREETYPE_H
+
+#include "baked_font.hpp"
+#include "glyph_rasterizer.hpp"
+
+/// @brief Width in pixels of baked atlases (grown if a glyph doesn't fit)
+static constexpr uint32_t ATLAS_WIDTH = 1024;
+
+/// @brief Empty pixels around each glyph, so linear filtering doesn't bleed into neighbours
+static constexpr uint32_t GLYPH_PADDING = 1;
+
+/// @brief Rasterized glyph waiting to be packed
+struct BakedGlyph {
+    /// @brief Glyph record
+    BakedFont::Glyph record;
+
+    /// @brief Tightly packed bitmap
+    std::vector<unsigned char> bitmap;
+};
+
+static void printUsage(const char *program) {
+    std::cerr
+        << "Usage: " << program << " <font.ttf> [options]\n"
+        << "Bakes a font into a file loaded by Font instead of rasterizing with FreeType\n\n"
+        << "Options:\n"
+        << "  --size <pixels>        font height in pixels (default 48)\n"
+        << "  --sdf                  bake signed distance field glyphs\n"
+        << "  --range <first>-<last> codepoints to bake, decimal or 0x hex, can be repeated (default 32-126)\n"
+        << "  --output <path>        output file (default next to the font, as Font looks for it)\n";
+}
+
+/// @brief Parses a codepoint range like "32-126" or "0x400-0x4FF"
+static bool parseRange(const std::string &str, std::pair<uint32_t, uint32_t> &range) {
+    size_t dash = str.find('-', 1);
+    if (dash == std::string::npos) return false;
+    try {
+        range.first = std::stoul(str.substr(0, dash), nullptr, 0);
+        range.second = std::stoul(str.substr(dash + 1), nullptr, 0);
+    } catch (const std::exception &) {
+        return false;
+    }
+    return range.first <= range.second;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Parse arguments
+    std::string ttfPath = argv[1];
+    std::string outputPath;
+    float fontHeight = 48.0f;
+    GlyphRenderMode renderMode = GlyphRenderMode::bitmap;
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) {
+            fontHeight = std::stof(argv[++i]);
+        } else if (arg == "--sdf") {
+            renderMode = GlyphRenderMode::sdf;
+        } else if (arg == "--range" && hasValue) {
+            std::pair<uint32_t, uint32_t> range;
+            if (!parseRange(argv[++i], range)) {
+                std::cerr << "Invalid range " << argv[i] << "\n";
+                return 1;
+            }
+            ranges.push_back(range);
+        } else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (ranges.empty()) ranges.emplace_back(CHARS_START, CHARS_START + CHARS_LEN - 1);
+    if (outputPath.empty()) outputPath = BakedFont::pathFor(ttfPath, fontHeight, renderMode);
+
+    // Open face
+    FT_Library ft;
+    FT_Face face;
+    if (FT_Init_FreeType(&ft) != 0) {
+        std::cerr << "Failed to initialize FreeType\n";
+        return 1;
+    }
+    GlyphRasterizer::setupLibrary(ft);
+    if (FT_New_Face(ft, ttfPath.c_str(), 0, &face) != 0) {
+        std::cerr << "Failed to open font " << ttfPath << "\n";
+        return 1;
+    }
+    FT_Set_Pixel_Sizes(face, 0, fontHeight);
+
+    // Font info, computed the same way Font does
+    BakedFont::Header header{};
+    const FT_Size_Metrics &metrics = face->size->metrics;
+    header.renderMode = (uint32_t)renderMode;
+    const std::optional<uint64_t> ttfHash = BakedFont::hashFile(ttfPath);
+    if (!ttfHash) {
+        std::cerr << "Failed to read font " << ttfPath << "\n";
+        return 1;
+    }
+    header.ttfHash = *ttfHash;
+    header.fontHeight = fontHeight;
+    header.maxCharUnderflow = (float)((-metrics.descender + 63) >> 6);
+    header.maxCharHeight = (float)((metrics.ascender + 63) >> 6) + header.maxCharUnderflow;
+
+    // Rasterize glyphs present on the font (missing ones are left for the runtime fallback)
+    std::vector<BakedGlyph> glyphs;
+    for (auto [first, last] : ranges) {
+        for (uint32_t codepoint = first; codepoint <= last; ++codepoint) {
+            if (FT_Get_Char_Index(face, codepoint) == 0) continue;
+            if (GlyphRasterizer::renderGlyph(face, codepoint, renderMode) != 0) {
+                std::cerr << "Failed to rasterize codepoint " << codepoint << ", skipping\n";
+                continue;
+            }
+
+            const FT_GlyphSlot slot = face->glyph;
+            const FT_Bitmap &bitmap = slot->bitmap;
+            BakedGlyph glyph;
+            glyph.record = BakedFont::Glyph{
+                codepoint,
+                0, 0,
+                bitmap.width, bitmap.rows,
+                (float)slot->bitmap_left, (float)slot->bitmap_top,
+                (float)(slot->advance.x >> 6)
+            };
+            glyph.bitmap.resize(bitmap.width * bitmap.rows);
+            for (unsigned int y = 0; y < bitmap.rows; ++y) {
+                std::memcpy(&glyph.bitmap[y * bitmap.width], bitmap.buffer + y * bitmap.pitch, bitmap.width);
+            }
+            glyphs.push_back(std::move(glyph));
+        }
+    }
+
+    // Pack glyphs on shelves, tallest first so shelves waste less space
+    std::vector<size_t> order(glyphs.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&glyphs](size_t a, size_t b) {
+        return glyphs[a].record.rows > glyphs[b].record.rows;
+    });
+
+    uint32_t atlasWidth = ATLAS_WIDTH;
+    for (auto &glyph : glyphs) {
+        atlasWidth = std::max(atlasWidth, glyph.record.width + 2 * GLYPH_PADDING);
+    }
+
+    uint32_t x = 0, y = 0, shelfHeight = 0;
+    for (size_t i : order) {
+        BakedFont::Glyph &record = glyphs[i].record;
+        const uint32_t width = record.width + 2 * GLYPH_PADDING;
+        const uint32_t height = record.rows + 2 * GLYPH_PADDING;
+        if (x + width > atlasWidth) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        record.x = x + GLYPH_PADDING;
+        record.y = y + GLYPH_PADDING;
+        x += width;
+        shelfHeight = std::max(shelfHeight, height);
+    }
+    header.atlasWidth = atlasWidth;
+    header.atlasHeight = std::max<uint32_t>(1, y + shelfHeight);
+
+    // Copy bitmaps to atlas
+    std::vector<unsigned char> pixels(header.atlasWidth * header.atlasHeight, 0);
+    std::vector<BakedFont::Glyph> records;
+    for (auto &glyph : glyphs) {
+        const BakedFont::Glyph &record = glyph.record;
+        for (uint32_t row = 0; row < record.rows; ++row) {
+            std::memcpy(
+                &pixels[(record.y + row) * header.atlasWidth + record.x],
+                &glyph.bitmap[row * record.width],
+                record.width
+            );
+        }
+        records.push_back(record);
+    }
+
+    // Kerning between every pair of baked glyphs, only non-zero ones are stored
+    std::vector<BakedFont::KerningPair> kerningPairs;
+    if (FT_HAS_KERNING(face)) {
+        for (auto &left : records) {
+            FT_UInt leftIndex = FT_Get_Char_Index(face, left.codepoint);
+            for (auto &right : records) {
+                FT_Vector kerning;
+                FT_UInt rightIndex = FT_Get_Char_Index(face, right.codepoint);
+                if (FT_Get_Kerning(face, leftIndex, rightIndex, FT_KERNING_DEFAULT, &kerning) != 0) continue;
+                if ((kerning.x >> 6) == 0) continue;
+                kerningPairs.push_back(BakedFont::KerningPair{left.codepoint, right.codepoint, (float)(kerning.x >> 6)});
+            }
+        }
+    }
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+
+    if (!BakedFont::write(outputPath, header, records, kerningPairs, pixels)) {
+        std::cerr << "Failed to write " << outputPath << "\n";
+        return 1;
+    }
+    std::cout
+        << "Baked " << records.size() << " glyphs into a "
+        << header.atlasWidth << "x" << header.atlasHeight << " atlas with "
+        << kerningPairs.size() << " kerning pairs: " << outputPath << "\n";
+    return 0;
+}
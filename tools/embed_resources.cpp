@@ -0,0 +1,106 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
+/// @brief File to embed
+struct Input {
+    /// @brief Name looked up at runtime, relative to the resources directory with '/' separators
+    std::string name;
+
+    /// @brief Contents
+    std::string data;
+};
+
+static void printUsage(const char *program) {
+    std::cerr
+        << "Usage: " << program << " <output.cpp> <resources directory> [files...]\n"
+        << "Writes a source file embedding files as constexpr byte arrays, served by Resources::open\n";
+}
+
+/// @brief Escapes a name to be written as a string literal
+static std::string escape(const std::string &str) {
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const std::filesystem::path outputPath = argv[1];
+    const std::filesystem::path baseDir = argv[2];
+
+    // Read inputs, sorted by name so they can be binary searched
+    std::vector<Input> inputs;
+    for (int i = 3; i < argc; ++i) {
+        std::ifstream file{argv[i], std::ios::binary};
+        if (!file) {
+            std::cerr << "Failed to read " << argv[i] << "\n";
+            return 1;
+        }
+        std::stringstream data;
+        data << file.rdbuf();
+
+        const std::string name = std::filesystem::path{argv[i]}.lexically_relative(baseDir).generic_string();
+        if (name.empty() || name.compare(0, 2, "..") == 0) {
+            std::cerr << argv[i] << " is not inside " << baseDir << "\n";
+            return 1;
+        }
+        inputs.push_back(Input{name, data.str()});
+    }
+    std::sort(inputs.begin(), inputs.end(), [](const Input &a, const Input &b) {
+        return a.name < b.name;
+    });
+
+    // Write arrays, then the lookup table
+    std::stringstream out;
+    out << "// Generated by embed-resources, do not edit\n\n";
+    out << "#include \"resources.hpp\"\n\n";
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const std::string &data = inputs[i].data;
+        out << "// " << inputs[i].name << "\n";
+        out << "alignas(16) static constexpr unsigned char RESOURCE_" << i << "[" << data.size() + 1 << "] = {";
+        for (size_t j = 0; j < data.size(); ++j) {
+            if (j % 16 == 0) out << "\n   ";
+            out << " " << (unsigned int)(unsigned char)data[j] << ",";
+        }
+
+        // Trailing zero, so text resources can be used as C strings
+        out << "\n    0\n};\n\n";
+    }
+
+    out << "extern const Resources::Embedded EMBEDDED_RESOURCES[];\n";
+    out << "const Resources::Embedded EMBEDDED_RESOURCES[] = {\n";
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        out << "    {\"" << escape(inputs[i].name) << "\", RESOURCE_" << i << ", " << inputs[i].data.size() << "},\n";
+    }
+
+    // Arrays can't be empty, count is what matters
+    if (inputs.empty()) out << "    {\"\", nullptr, 0},\n";
+    out << "};\n\n";
+    out << "extern const size_t EMBEDDED_RESOURCES_COUNT;\n";
+    out << "const size_t EMBEDDED_RESOURCES_COUNT = " << inputs.size() << ";\n";
+
+    const std::string contents = out.str();
+    std::error_code error;
+    if (outputPath.has_parent_path()) std::filesystem::create_directories(outputPath.parent_path(), error);
+    std::ofstream file{outputPath, std::ios::binary | std::ios::trunc};
+    file << contents;
+    if (!file) {
+        std::cerr << "Failed to write " << outputPath << "\n";
+        return 1;
+    }
+
+    std::cout << "Embedded " << inputs.size() << " resources into " << outputPath.string() << "\n";
+    return 0;
+}